@@ -0,0 +1,95 @@
+/**
+ * @file
+ * Minimal timing harness for eostd_bench
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace eostd { namespace bench {
+
+   /**
+    * A timed body. It is called with the number of iterations it has to run.
+    */
+   using body = std::function<void(uint64_t iterations)>;
+
+   struct benchmark {
+      std::string           name;
+      size_t                bytes; ///< bytes consumed per iteration, 0 when it does not apply
+      body                  run;
+      std::function<void()> setup; ///< run once, untimed, before the benchmark is measured
+   };
+
+   std::vector<benchmark>& registry();
+
+   /**
+    * Registers a benchmark
+    * @brief Registers a benchmark
+    *
+    * @param name - Benchmark name, conventionally `primitive/operation`
+    * @param bytes - Input bytes per iteration, used to report ns/byte
+    * @param run - Body running the given number of iterations
+    * @param setup - Optional untimed preparation, e.g. filling a large table, skipped
+    *                when the benchmark is filtered out
+    */
+   inline void add(std::string name, size_t bytes, body run, std::function<void()> setup = {}) {
+      registry().push_back({std::move(name), bytes, std::move(run), std::move(setup)});
+   }
+
+   inline uint64_t& counted() {
+      static uint64_t n = 0;
+      return n;
+   }
+
+   /**
+    * Adds to what the running benchmark counts besides time, e.g. db intrinsic calls.
+    * It is reported per iteration in the "count/call" column.
+    */
+   inline void count(uint64_t n) {
+      counted() += n;
+   }
+
+   /**
+    * Keeps the compiler from discarding `value` or the work that produced it
+    */
+   template<typename T>
+   inline void do_not_optimize(const T& value) {
+      asm volatile("" : : "r,m"(value) : "memory");
+   }
+
+   /**
+    * Forces pending writes to memory to be considered observable
+    */
+   inline void clobber_memory() {
+      asm volatile("" : : : "memory");
+   }
+
+   /**
+    * Deterministic filler for benchmark inputs
+    */
+   inline std::vector<uint8_t> make_input(size_t size, uint8_t seed = 0) {
+      std::vector<uint8_t> v(size);
+      uint32_t x = 0x9e3779b9u ^ seed;
+      for (auto& b : v) {
+         x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+         b = static_cast<uint8_t>(x);
+      }
+      return v;
+   }
+
+   struct registrar {
+      explicit registrar(void (*fn)()) { fn(); }
+   };
+
+} } /// namespace eostd::bench
+
+/**
+ * Defines a function registering a group of benchmarks at startup
+ */
+#define EOSTD_BENCHMARKS(group) \
+   static void group(); \
+   static ::eostd::bench::registrar group##_registrar(group); \
+   static void group()
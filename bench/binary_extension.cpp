@@ -0,0 +1,76 @@
+#include "bench.hpp"
+
+#include <eostd/binary_extension.hpp>
+#include <eosio/datastream.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace eostd;
+using eosio::pack;
+using eosio::unpack;
+
+namespace {
+
+   void fail(const char* what, size_t size) {
+      std::fprintf(stderr, "binary_extension %s mismatch for a %zu byte payload\n", what, size);
+      std::abort();
+   }
+
+   // every payload type has to read and write the wire format eosio::binary_extension does
+   void verify_wire_format() {
+      for (size_t size : { 0, 1, 127, 128, 4096 }) {
+         auto input = bench::make_input(size);
+         const std::vector<char> payload(input.begin(), input.end());
+         const std::string text(input.begin(), input.end());
+         const auto wire = pack(eosio::binary_extension<std::vector<char>>(payload));
+
+         if (pack(eostd::binary_extension<std::vector<char>>(payload)) != wire)
+            fail("vector<char> pack", size);
+         if (pack(eostd::binary_extension<std::string>(text)) != wire)
+            fail("string pack", size);
+         if (pack(eostd::binary_extension<std::string_view>(text)) != wire)
+            fail("string_view pack", size);
+
+         if (unpack<eostd::binary_extension<std::vector<char>>>(wire).value() != payload)
+            fail("vector<char> unpack", size);
+         if (unpack<eostd::binary_extension<std::string>>(wire).value() != text)
+            fail("string unpack", size);
+
+         auto view = unpack<eostd::binary_extension<std::string_view>>(wire);
+         if (view.value() != text || view->data() + view->size() != wire.data() + wire.size())
+            fail("string_view unpack", size);
+      }
+
+      // an absent extension is written as nothing and read back as absent
+      if (!pack(eostd::binary_extension<std::string_view>()).empty() || unpack<eostd::binary_extension<std::string>>(std::vector<char>()))
+         fail("empty extension", 0);
+   }
+
+   template<typename Extension>
+   void add_decode(const std::string& name, size_t size) {
+      bench::add("binary_extension/" + name + " (" + std::to_string(size) + " bytes)", size, [size](uint64_t n) {
+         auto input = bench::make_input(size);
+         const auto wire = pack(std::vector<char>(input.begin(), input.end()));
+         for (uint64_t i = 0; i < n; ++i) {
+            Extension be;
+            eosio::datastream<const char*> ds(wire.data(), wire.size());
+            ds >> be;
+            bench::do_not_optimize(be);
+            bench::clobber_memory();
+         }
+      });
+   }
+
+}
+
+EOSTD_BENCHMARKS(binary_extension_benchmarks) {
+   verify_wire_format();
+
+   for (size_t size : { 64, 4096 }) {
+      add_decode<eosio::binary_extension<std::vector<char>>>("eosio decode", size);
+      add_decode<eostd::binary_extension<std::vector<char>>>("decode", size);
+      add_decode<eostd::binary_extension<std::string_view>>("view decode", size);
+   }
+}
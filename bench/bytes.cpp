@@ -0,0 +1,125 @@
+#include "bench.hpp"
+
+#include <eostd/bytes.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace eostd;
+
+namespace {
+
+   template<typename Bytes>
+   void expect_equal(const Bytes& b, const bytes& expected, const char* what, size_t step) {
+      if (b.size() != expected.size() || !std::equal(b.begin(), b.end(), expected.begin())) {
+         std::fprintf(stderr, "small_bytes %s mismatch at step %zu\n", what, step);
+         std::abort();
+      }
+   }
+
+   // small_bytes has to hold what std::vector holds through every way of growing it
+   void verify_small_bytes(byte_arena* arena) {
+      auto ops = bench::make_input(4000, 5);
+      auto input = bench::make_input(300, 6);
+      small_bytes<32> b(arena);
+      bytes expected;
+
+      for (size_t i = 0; i < ops.size(); ++i) {
+         switch (ops[i] % 6) {
+            case 0:
+               b.push_back(ops[i]);
+               expected.push_back(ops[i]);
+               break;
+            case 1: {
+               const size_t size = ops[i] % 50;
+               b.append(input.data(), size);
+               expected.insert(expected.end(), input.begin(), input.begin() + size);
+               break;
+            }
+            case 2:
+               b.resize(ops[i] % 200);
+               expected.resize(ops[i] % 200);
+               break;
+            case 3: {
+               small_bytes<32> copy = b;
+               expect_equal(copy, expected, "copy", i);
+               b = std::move(copy);
+               break;
+            }
+            case 4: {
+               small_bytes<32> moved(std::move(b));
+               b = moved;
+               break;
+            }
+            default:
+               if (expected.size() > 250) {
+                  b.clear();
+                  expected.clear();
+               }
+               break;
+         }
+         expect_equal(b, expected, "content", i);
+      }
+
+      const byte_span view = b;
+      if (view.data() != b.data() || view.size() != b.size()) {
+         std::fprintf(stderr, "small_bytes span mismatch\n");
+         std::abort();
+      }
+   }
+
+   void verify_arena() {
+      // small enough that buffers also spill to the heap
+      inline_arena<1024> arena;
+      verify_small_bytes(&arena);
+      if (arena.high_water() == 0 || arena.spills() == 0) {
+         std::fprintf(stderr, "byte_arena not exercised: high water %zu, %u spills\n", arena.high_water(), arena.spills());
+         std::abort();
+      }
+
+      // the most recent allocation is given back, older ones are not
+      arena.reset();
+      void* a = arena.allocate(100);
+      void* b = arena.allocate(100);
+      arena.deallocate(a, 100);
+      arena.deallocate(b, 100);
+      if (arena.used() != 100) {
+         std::fprintf(stderr, "byte_arena holds %zu bytes, expected 100\n", arena.used());
+         std::abort();
+      }
+   }
+
+   /// builds a short-lived buffer of `size` bytes the way hashing and signing code does
+   template<typename Make>
+   void add_buffer(const std::string& name, size_t size, Make make) {
+      bench::add("bytes/" + name + " (" + std::to_string(size) + " bytes)", size, [size, make](uint64_t n) {
+         auto input = bench::make_input(size);
+         for (uint64_t i = 0; i < n; ++i) {
+            auto b = make(input.data(), size);
+            bench::do_not_optimize(b.data());
+            bench::clobber_memory();
+         }
+      });
+   }
+
+}
+
+EOSTD_BENCHMARKS(bytes_benchmarks) {
+   verify_small_bytes(nullptr);
+   verify_arena();
+
+   static inline_arena<4096> arena;
+
+   for (size_t size : { 32, 64, 256 }) {
+      add_buffer("std::vector", size, [](const byte* data, size_t size) {
+         return bytes(data, data + size);
+      });
+      add_buffer("small_bytes", size, [](const byte* data, size_t size) {
+         return small_bytes<>(data, size);
+      });
+      add_buffer("small_bytes+arena", size, [](const byte* data, size_t size) {
+         arena.reset();
+         return small_bytes<>(data, size, &arena);
+      });
+   }
+}
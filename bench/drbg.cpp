@@ -0,0 +1,106 @@
+#include "bench.hpp"
+
+#include <eostd/crypto/drbg_stream.hpp>
+
+#include <type_traits>
+
+using namespace eostd;
+
+static_assert(!std::is_copy_constructible<drbg_stream<>>::value && !std::is_copy_assignable<drbg_stream<>>::value,
+              "copies of a drbg_stream would repeat its buffered bytes");
+
+EOSTD_BENCHMARKS(drbg_benchmarks) {
+   bench::add("hash_drbg/instantiate", 0, [](uint64_t n) {
+      auto entropy = bench::make_input(32);
+      for (uint64_t i = 0; i < n; ++i) {
+         hash_drbg drbg(entropy.data(), entropy.size());
+         bench::do_not_optimize(drbg);
+      }
+   });
+
+   bench::add("hash_drbg/reseed", 0, [](uint64_t n) {
+      auto entropy = bench::make_input(32);
+      hash_drbg drbg(entropy.data(), entropy.size());
+      for (uint64_t i = 0; i < n; ++i) {
+         drbg.incorporate_entropy(entropy.data(), entropy.size());
+         bench::clobber_memory();
+      }
+   });
+
+   for (size_t size : {4, 8, 32, 256, 4096, 65536}) {
+      bench::add("hash_drbg/generate_block", size, [size](uint64_t n) {
+         auto entropy = bench::make_input(32);
+         hash_drbg drbg(entropy.data(), entropy.size());
+         bytes output(size);
+         for (uint64_t i = 0; i < n; ++i) {
+            drbg.generate_block(output.data(), output.size());
+            bench::clobber_memory();
+         }
+      });
+   }
+
+   bench::add("hash_drbg/generate_block+additional", 32, [](uint64_t n) {
+      auto entropy = bench::make_input(32);
+      auto additional = bench::make_input(32, 1);
+      hash_drbg drbg(entropy.data(), entropy.size());
+      byte output[32];
+      for (uint64_t i = 0; i < n; ++i) {
+         drbg.generate_block(additional.data(), additional.size(), output, sizeof(output));
+         bench::do_not_optimize(output);
+      }
+   });
+}
+
+EOSTD_BENCHMARKS(drbg_stream_benchmarks) {
+   bench::add("hash_drbg/next_u64 via generate_block", 8, [](uint64_t n) {
+      auto entropy = bench::make_input(32);
+      hash_drbg drbg(entropy.data(), entropy.size());
+      for (uint64_t i = 0; i < n; ++i) {
+         uint64_t value;
+         drbg.generate_block(reinterpret_cast<byte*>(&value), sizeof(value));
+         bench::do_not_optimize(value);
+      }
+   });
+
+   bench::add("drbg_stream/next_u64", 8, [](uint64_t n) {
+      auto entropy = bench::make_input(32);
+      hash_drbg drbg(entropy.data(), entropy.size());
+      drbg_stream<> stream(drbg);
+      for (uint64_t i = 0; i < n; ++i) {
+         bench::do_not_optimize(stream.next_u64());
+      }
+   });
+
+   bench::add("drbg_stream/uniform(6)", 0, [](uint64_t n) {
+      auto entropy = bench::make_input(32);
+      hash_drbg drbg(entropy.data(), entropy.size());
+      drbg_stream<> stream(drbg);
+      for (uint64_t i = 0; i < n; ++i) {
+         bench::do_not_optimize(stream.uniform(6));
+      }
+   });
+
+   bench::add("drbg_stream/shuffle 1000", 0, [](uint64_t n) {
+      auto entropy = bench::make_input(32);
+      hash_drbg drbg(entropy.data(), entropy.size());
+      drbg_stream<> stream(drbg);
+      std::vector<uint32_t> deck(1000);
+      for (uint32_t i = 0; i < deck.size(); ++i)
+         deck[i] = i;
+      for (uint64_t i = 0; i < n; ++i) {
+         stream.shuffle(deck.begin(), deck.end());
+         bench::clobber_memory();
+      }
+   });
+
+   bench::add("drbg_stream/read", 1 << 20, [](uint64_t n) {
+      auto entropy = bench::make_input(32);
+      hash_drbg drbg(entropy.data(), entropy.size());
+      drbg_stream<> stream(drbg);
+      bytes output(1 << 20);
+      for (uint64_t i = 0; i < n; ++i) {
+         stream.read(output.data(), output.size());
+         bench::clobber_memory();
+      }
+   });
+}
@@ -0,0 +1,55 @@
+#include "bench.hpp"
+
+#include <eostd/hex.hpp>
+
+using namespace eostd;
+using namespace eostd::literals;
+
+// std::array's operator== is not constexpr before C++20
+static_assert("00ff7fA0"_hex[1] == 0xff && "00ff7fA0"_hex[3] == 0xa0 && "00ff7fA0"_hex.size() == 4);
+static_assert("abc"_hex[0] == 0x0a && "abc"_hex[1] == 0xbc);
+static_assert(hex_literal("0102")[1] == 0x02);
+static_assert(""_hex.empty());
+
+EOSTD_BENCHMARKS(hex_benchmarks) {
+   for (size_t size : {20, 32, 256, 4096}) {
+      bench::add("hex/to_hex string", size, [size](uint64_t n) {
+         auto input = bench::make_input(size);
+         auto data = reinterpret_cast<const char*>(input.data());
+         for (uint64_t i = 0; i < n; ++i) {
+            auto s = to_hex(data, size);
+            bench::do_not_optimize(s);
+         }
+      });
+
+      bench::add("hex/to_hex buffer", size, [size](uint64_t n) {
+         auto input = bench::make_input(size);
+         std::vector<char> out(2 * size);
+         for (uint64_t i = 0; i < n; ++i) {
+            to_hex(input.data(), size, out.data());
+            bench::clobber_memory();
+         }
+      });
+
+      bench::add("hex/from_hex", size, [size](uint64_t n) {
+         auto input = bench::make_input(size);
+         auto s = to_hex(reinterpret_cast<const char*>(input.data()), size);
+         std::vector<char> out(size);
+         for (uint64_t i = 0; i < n; ++i) {
+            bench::do_not_optimize(from_hex(s, out.data(), out.size()));
+            bench::clobber_memory();
+         }
+      });
+   }
+
+   bench::add("hex/to_hex<32> checksum", 32, [](uint64_t n) {
+      std::array<uint8_t, 32> checksum;
+      auto input = bench::make_input(32);
+      std::copy(input.begin(), input.end(), checksum.begin());
+      for (uint64_t i = 0; i < n; ++i) {
+         bench::clobber_memory();
+         auto h = to_hex(checksum);
+         bench::do_not_optimize(h);
+      }
+   });
+}
@@ -0,0 +1,76 @@
+// Built with EOSTD_HEX_COMPILED whichever way eostd is configured. hex.hpp is included
+// from this file and from hex_compiled_peer.cpp, so the program only links if the
+// out-of-line codecs are defined once, in src/hex.cpp, and the results have to match
+// the ones eostd_bench gets from the inline codecs.
+#include "bench.hpp"
+
+#include <eostd/hex.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace eostd;
+
+namespace eostd { namespace hex_compiled {
+
+   std::string encode(const std::vector<char>& data);
+   size_t decode(std::string_view s, char* out, size_t outlen);
+
+} } /// namespace eostd::hex_compiled
+
+namespace {
+
+   [[noreturn]] void fail(const char* what, size_t size) {
+      std::fprintf(stderr, "hex compiled: %s, %zu bytes\n", what, size);
+      std::abort();
+   }
+
+   std::string reference_hex(const std::vector<uint8_t>& data) {
+      static const char digits[] = "0123456789abcdef";
+      std::string s;
+      for (uint8_t b : data) {
+         s += digits[b >> 4];
+         s += digits[b & 0xf];
+      }
+      return s;
+   }
+
+}
+
+int main() {
+   using namespace eostd::literals;
+
+   constexpr auto known = "00ff7fA0"_hex;
+   if (to_hex(known) != std::array<char, 8>{ '0', '0', 'f', 'f', '7', 'f', 'a', '0' })
+      fail("to_hex<4>", known.size());
+
+   // sizes around the 8-byte SWAR blocks of both codecs
+   for (size_t size : {0, 1, 7, 8, 9, 16, 31, 32, 100}) {
+      const auto input = bench::make_input(size, 5);
+      const std::vector<char> chars(input.begin(), input.end());
+      const auto expected = reference_hex(input);
+
+      std::string buffer(2 * size, '\0');
+      to_hex(input.data(), size, buffer.data());
+      if (buffer != expected)
+         fail("to_hex buffer", size);
+      if (to_hex(chars.data(), size) != expected || hex_compiled::encode(chars) != expected)
+         fail("to_hex string", size);
+
+      std::vector<char> out(size);
+      std::string upper = "0x" + expected;
+      for (auto& c : upper)
+         if (c >= 'a' && c <= 'f')
+            c += 'A' - 'a';
+      if (hex_compiled::decode(upper, out.data(), size) != size || out != chars)
+         fail("from_hex", size);
+      if (size && (try_from_hex(expected.substr(0, 2 * size - 1) + "g", out.data(), size) != hex_npos))
+         fail("try_from_hex accepted a non-hex char", size);
+   }
+
+   if (from_hex('B') != 11)
+      fail("from_hex(char)", 1);
+
+   std::printf("hex compiled: ok\n");
+   return 0;
+}
@@ -0,0 +1,14 @@
+// second translation unit of eostd_hex_compiled, see hex_compiled.cpp
+#include <eostd/hex.hpp>
+
+namespace eostd { namespace hex_compiled {
+
+   std::string encode(const std::vector<char>& data) {
+      return to_hex(data);
+   }
+
+   size_t decode(std::string_view s, char* out, size_t outlen) {
+      return from_hex(s, out, outlen);
+   }
+
+} } /// namespace eostd::hex_compiled
@@ -0,0 +1,102 @@
+#include "bench.hpp"
+
+#include <eostd/log.hpp>
+#include <eostd/native/print.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace eostd;
+using namespace eostd::literals;
+
+namespace {
+
+   static_assert(!log_enabled(log_level::off), "off is never logged");
+   static_assert(log_enabled(log_level::info) || !log_enabled(log_level::debug), "levels are enabled from the top");
+
+   /// what `print` printed and how many print intrinsic calls it took
+   template<typename Print>
+   std::pair<std::string, uint64_t> printed(Print&& print) {
+      std::string out;
+      native::capture_prints(&out);
+      const uint64_t calls = native::print_calls();
+      print();
+      const uint64_t made = native::print_calls() - calls;
+      native::capture_prints(nullptr);
+      return { out, made };
+   }
+
+   // print_buffered has to print what eosio::print prints, in one call unless it falls back
+   template<typename... Args>
+   void expect_same(uint64_t expected_calls, const Args&... args) {
+      const auto plain = printed([&] { eosio::print(args...); });
+      const auto buffered = printed([&] { print_buffered(args...); });
+      if (buffered.first != plain.first || buffered.second != expected_calls) {
+         std::fprintf(stderr, "print_buffered printed \"%s\" in %llu calls, expected \"%s\" in %llu\n",
+            buffered.first.c_str(), static_cast<unsigned long long>(buffered.second), plain.first.c_str(),
+            static_cast<unsigned long long>(expected_calls));
+         std::abort();
+      }
+   }
+
+   void verify_log() {
+      expect_same(1, "transfer ", "alice"_n, " -> ", "bob.x"_n, " ", int64_t(-12345), " ", "EOS@eosio.token"_xsym);
+      expect_same(1, uint8_t(0), ' ', true, false, int8_t(-128), uint64_t(-1), int64_t(INT64_MIN), std::string("str"));
+      expect_same(1, uint128_t(-1), int128_t(uint128_t(1) << 127), symbol_code("ABCDEFG"), "zzzzzzzzzzzzj"_n, name());
+      expect_same(1, extended_symbol_code(), "1.2.3"_n, "a"_n, symbol_code());
+      // floating point goes through eosio::print, between the buffered parts
+      expect_same(3, "ratio ", 0.5, " ok");
+
+      // longer messages are printed in buffer-sized pieces
+      const std::string long_text(EOSTD_LOG_BUFFER_SIZE + 10, 'x');
+      expect_same(2, long_text);
+      expect_same(2, long_text.substr(0, EOSTD_LOG_BUFFER_SIZE - 3), "eosio.token"_n);
+
+      const auto f = printed([] { print_buffered(field("from", "alice"_n), ' ', field("amount", 12)); });
+      if (f.first != "from=alice amount=12" || f.second != 1) {
+         std::fprintf(stderr, "log field printed \"%s\"\n", f.first.c_str());
+         std::abort();
+      }
+
+      const auto off = printed([] { log<log_level::off>("never"); });
+      if (off.second != 0) {
+         std::fprintf(stderr, "log_level::off printed \"%s\"\n", off.first.c_str());
+         std::abort();
+      }
+   }
+
+   /// logs a transfer line with `print`, with printing captured so it does not reach stdout
+   template<typename Print>
+   void add_log(const std::string& what, Print print) {
+      bench::add("log/" + what, 0, [print](uint64_t n) {
+         static std::string out;
+         native::capture_prints(&out);
+         const uint64_t calls = native::print_calls();
+         const name from = "alice"_n, to = "bob"_n;
+         const auto xsym = "EOS@eosio.token"_xsym;
+         for (uint64_t i = 0; i < n; ++i) {
+            out.clear();
+            print(from, to, static_cast<int64_t>(i), xsym);
+            bench::clobber_memory();
+         }
+         bench::count(native::print_calls() - calls);
+         native::capture_prints(nullptr);
+      });
+   }
+
+}
+
+EOSTD_BENCHMARKS(log_benchmarks) {
+   verify_log();
+
+   add_log("eosio::print", [](name from, name to, int64_t amount, const extended_symbol_code& xsym) {
+      eosio::print("transfer ", from, " -> ", to, " ", amount, " ", xsym, "\n");
+   });
+   add_log("print_buffered", [](name from, name to, int64_t amount, const extended_symbol_code& xsym) {
+      print_buffered("transfer ", from, " -> ", to, " ", amount, " ", xsym, "\n");
+   });
+   add_log("dlog (level " + std::to_string(EOSTD_LOG_LEVEL) + ")", [](name from, name to, int64_t amount, const extended_symbol_code& xsym) {
+      dlog("transfer ", from, " -> ", to, " ", amount, " ", xsym, "\n");
+   });
+}
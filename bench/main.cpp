@@ -0,0 +1,142 @@
+#include "bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace eostd { namespace bench {
+
+   std::vector<benchmark>& registry() {
+      static std::vector<benchmark> benchmarks;
+      return benchmarks;
+   }
+
+} } /// namespace eostd::bench
+
+namespace {
+
+   /// heap use of the whole process, kept by the operator new below
+   struct heap_counters {
+      uint64_t allocations = 0;
+      size_t   live        = 0;
+      size_t   peak        = 0;
+   } heap;
+
+   // each block is prefixed with its size, padded to keep the block max-aligned
+   constexpr size_t heap_header = alignof(std::max_align_t);
+
+}
+
+void* operator new(size_t size) {
+   auto p = static_cast<char*>(std::malloc(size + heap_header));
+   if (!p)
+      throw std::bad_alloc();
+   std::memcpy(p, &size, sizeof(size));
+   ++heap.allocations;
+   heap.live += size;
+   heap.peak = std::max(heap.peak, heap.live);
+   return p + heap_header;
+}
+
+void operator delete(void* p) noexcept {
+   if (!p)
+      return;
+   auto block = static_cast<char*>(p) - heap_header;
+   size_t size;
+   std::memcpy(&size, block, sizeof(size));
+   heap.live -= size;
+   std::free(block);
+}
+
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+
+namespace {
+
+   using clock = std::chrono::steady_clock;
+
+   /// what the last round of a benchmark cost
+   struct result {
+      double   elapsed;       ///< ns
+      uint64_t allocations;
+      size_t   peak_heap;     ///< most heap bytes in use at once, above what was in use before
+      uint64_t counted;       ///< what the benchmark passed to bench::count
+   };
+
+   result measure(const eostd::bench::benchmark& b, double min_time, uint64_t& iterations) {
+      iterations = 1;
+      for (;;) {
+         const uint64_t allocations = heap.allocations;
+         const size_t live = heap.live;
+         heap.peak = live;
+         eostd::bench::counted() = 0;
+         auto start = clock::now();
+         b.run(iterations);
+         double elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+         result r = { elapsed, heap.allocations - allocations, heap.peak - live, eostd::bench::counted() };
+         if (elapsed >= min_time * 1e9 || iterations >= (uint64_t(1) << 40))
+            return r;
+         // aim a bit past the target so the next round is most likely the last one
+         double scale = elapsed > 0 ? (min_time * 1e9 * 1.4) / elapsed : 100;
+         iterations = static_cast<uint64_t>(iterations * std::min(std::max(scale, 2.0), 100.0));
+      }
+   }
+
+   bool selected(const std::string& name, const std::vector<const char*>& filters) {
+      if (filters.empty())
+         return true;
+      for (auto f : filters)
+         if (name.find(f) != std::string::npos)
+            return true;
+      return false;
+   }
+
+}
+
+int main(int argc, char** argv) {
+   double min_time = 0.2;
+   std::vector<const char*> filters;
+
+   for (int i = 1; i < argc; ++i) {
+      if (std::strncmp(argv[i], "--min-time=", 11) == 0) {
+         min_time = std::atof(argv[i] + 11);
+      } else if (std::strcmp(argv[i], "--help") == 0) {
+         std::printf("usage: %s [--min-time=SECONDS] [FILTER...]\n", argv[0]);
+         return 0;
+      } else {
+         filters.push_back(argv[i]);
+      }
+   }
+
+   std::printf("%-44s %8s %14s %12s %10s %12s %10s %12s\n", "benchmark", "bytes", "iterations", "ns/call", "ns/byte",
+      "allocs/call", "peak heap", "count/call");
+   for (const auto& b : eostd::bench::registry()) {
+      if (!selected(b.name, filters))
+         continue;
+      if (b.setup)
+         b.setup();
+
+      uint64_t iterations;
+      const auto r = measure(b, min_time, iterations);
+      double per_call = r.elapsed / iterations;
+      double allocs_per_call = static_cast<double>(r.allocations) / iterations;
+
+      // columns that do not apply to a benchmark are shown as "-"
+      // wide enough for any uint64_t or double printed below
+      char bytes[24] = "-", per_byte[24] = "-", counted[24] = "-";
+      if (b.bytes) {
+         std::snprintf(bytes, sizeof(bytes), "%zu", b.bytes);
+         std::snprintf(per_byte, sizeof(per_byte), "%.3f", per_call / b.bytes);
+      }
+      if (r.counted)
+         std::snprintf(counted, sizeof(counted), "%.2f", static_cast<double>(r.counted) / iterations);
+
+      std::printf("%-44s %8s %14llu %12.2f %10s %12.2f %10zu %12s\n", b.name.c_str(), bytes,
+         static_cast<unsigned long long>(iterations), per_call, per_byte, allocs_per_call, r.peak_heap, counted);
+      std::fflush(stdout);
+   }
+   return 0;
+}
@@ -0,0 +1,256 @@
+#include "bench.hpp"
+
+#include <eostd/crypto/sha256.hpp>
+#include <eostd/hex.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace eostd;
+
+namespace {
+
+   struct batch {
+      std::vector<bytes>       messages;
+      std::vector<const byte*> inputs;
+      std::vector<size_t>      lengths;
+      std::vector<byte>        digests;
+
+      batch(size_t count, size_t min_size, size_t max_size) {
+         for (size_t i = 0; i < count; ++i) {
+            messages.push_back(bench::make_input(min_size + (max_size - min_size) * i / (count > 1 ? count - 1 : 1), i));
+            inputs.push_back(messages.back().data());
+            lengths.push_back(messages.back().size());
+         }
+         digests.resize(count * sha256::digest_size);
+      }
+
+      byte (*out())[sha256::digest_size] {
+         return reinterpret_cast<byte(*)[sha256::digest_size]>(digests.data());
+      }
+   };
+
+   // sha256_many has to agree with the single-stream path before its numbers mean anything
+   void verify_sha256_many() {
+      for (size_t count : {1, 3, 4, 5, 8, 9, 17}) {
+         batch b(count, 0, 200);
+         sha256_many(b.inputs.data(), b.lengths.data(), b.out(), count);
+
+         for (size_t i = 0; i < count; ++i) {
+            sha256 h;
+            byte digest[sha256::digest_size];
+            h.update(b.inputs[i], b.lengths[i]);
+            h.final(digest);
+            if (std::memcmp(digest, b.out()[i], sizeof(digest)) != 0) {
+               std::fprintf(stderr, "sha256_many mismatch: count %zu, message %zu (%zu bytes)\n", count, i, b.lengths[i]);
+               std::abort();
+            }
+         }
+      }
+   }
+
+
+   // the intrinsic (or its native stand-in) and the software path must agree
+   void verify_sha256_digest() {
+      using namespace eostd::literals;
+      constexpr auto abc = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"_hex;
+      std::array<byte, sha256::digest_size> known;
+      sha256_digest(reinterpret_cast<const byte*>("abc"), 3, known.data());
+      if (known != abc) {
+         std::fprintf(stderr, "sha256_digest(\"abc\") = %.64s\n", to_hex(known).data());
+         std::abort();
+      }
+
+      for (size_t size : {0, 1, 55, 56, 64, 300, 1000}) {
+         auto input = bench::make_input(size);
+         byte expected[sha256::digest_size], digest[sha256::digest_size];
+
+         sha256 h;
+         h.update(input.data(), input.size());
+         h.final(expected);
+
+         sha256_digest(input.data(), input.size(), digest);
+         if (std::memcmp(digest, expected, sizeof(digest)) != 0) {
+            std::fprintf(stderr, "sha256_digest mismatch: %zu bytes\n", size);
+            std::abort();
+         }
+
+         sha256_oneshot<> o;
+         for (size_t i = 0; i < size; i += 7)
+            o.update(input.data() + i, std::min<size_t>(7, size - i));
+         o.final(digest);
+         if (std::memcmp(digest, expected, sizeof(digest)) != 0) {
+            std::fprintf(stderr, "sha256_oneshot mismatch: %zu bytes\n", size);
+            std::abort();
+         }
+      }
+   }
+
+   /// whether `f` aborts, run in a child process so that the bench carries on
+   template<typename F>
+   bool aborts(F&& f) {
+      std::fflush(nullptr);
+      const pid_t pid = fork();
+      if (pid == 0) {
+         std::freopen("/dev/null", "w", stderr);
+         f();
+         std::_Exit(0);
+      }
+      int status = 0;
+      waitpid(pid, &status, 0);
+      return WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT;
+   }
+
+   // hashing a prefix, exporting its midstate and hashing the suffix on top of it must give
+   // the digest of the whole message, whether the midstate is resumed in the same object,
+   // a fresh one or one that hashed something else before
+   void verify_sha256_midstate() {
+      auto input = bench::make_input(1000, 3);
+      for (size_t prefix : {0, 64, 128, 640}) {
+         for (size_t suffix : {0, 1, 55, 56, 64, 200}) {
+            byte expected[sha256::digest_size], digest[sha256::digest_size];
+            sha256_digest(input.data(), prefix + suffix, expected);
+
+            sha256 h;
+            h.update(input.data(), prefix);
+            const auto m = h.midstate();
+            if (m.length != prefix) {
+               std::fprintf(stderr, "sha256 midstate length %llu after %zu bytes\n", static_cast<unsigned long long>(m.length), prefix);
+               std::abort();
+            }
+
+            sha256 fresh(m), reused;
+            reused.update(input.data(), 3);
+            reused.init(m);
+            h.init(m);
+            for (sha256* r : {&h, &fresh, &reused}) {
+               r->update(input.data() + prefix, suffix);
+               r->final(digest);
+               if (std::memcmp(digest, expected, sizeof(digest)) != 0) {
+                  std::fprintf(stderr, "sha256 midstate mismatch: %zu + %zu bytes\n", prefix, suffix);
+                  std::abort();
+               }
+            }
+         }
+      }
+
+      // off a block boundary the buffered tail is not in the state, so export is refused
+      for (size_t offset : {1, 63, 65, 200}) {
+         if (!aborts([&] { sha256 h; h.update(input.data(), offset); h.midstate(); })) {
+            std::fprintf(stderr, "sha256 midstate exported after %zu bytes\n", offset);
+            std::abort();
+         }
+      }
+   }
+
+}
+
+EOSTD_BENCHMARKS(sha256_benchmarks) {
+   // per-block cost of SHA256Transform; configure with CMAKE_C_FLAGS=-DSHA256_ZEROIZE_BLOCKS
+   // to compare against wiping the stack after every block
+   for (size_t size : {32, 55, 64, 256, 1024, 16384}) {
+      bench::add("sha256/update+final", size, [size](uint64_t n) {
+         auto input = bench::make_input(size);
+         sha256 h;
+         byte digest[sha256::digest_size];
+         for (uint64_t i = 0; i < n; ++i) {
+            h.update(input.data(), input.size());
+            h.final(digest);
+            bench::do_not_optimize(digest);
+         }
+      });
+   }
+
+   verify_sha256_many();
+   verify_sha256_digest();
+   verify_sha256_midstate();
+
+   for (size_t size : {32, 256, 1024}) {
+      bench::add("sha256/sha256_digest", size, [size](uint64_t n) {
+         auto input = bench::make_input(size);
+         byte digest[sha256::digest_size];
+         for (uint64_t i = 0; i < n; ++i) {
+            sha256_digest(input.data(), input.size(), digest);
+            bench::do_not_optimize(digest);
+         }
+      });
+   }
+
+   // batches of 64 equally sized messages, single-stream vs multi-buffer
+   for (size_t size : {32, 64, 128, 1024}) {
+      bench::add("sha256/batch64 single", 64 * size, [size](uint64_t n) {
+         batch b(64, size, size);
+         sha256 h;
+         for (uint64_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < 64; ++j) {
+               h.update(b.inputs[j], b.lengths[j]);
+               h.final(b.out()[j]);
+            }
+            bench::clobber_memory();
+         }
+      });
+
+      bench::add("sha256/batch64 sha256_many", 64 * size, [size](uint64_t n) {
+         batch b(64, size, size);
+         for (uint64_t i = 0; i < n; ++i) {
+            sha256_many(b.inputs.data(), b.lengths.data(), b.out(), 64);
+            bench::clobber_memory();
+         }
+      });
+   }
+
+   bench::add("sha256/construct", 0, [](uint64_t n) {
+      for (uint64_t i = 0; i < n; ++i) {
+         sha256 h;
+         bench::do_not_optimize(h);
+      }
+   });
+
+   // a 128-byte prefix shared by every message, followed by a 32-byte suffix
+   bench::add("sha256/prefix+suffix rehash", 160, [](uint64_t n) {
+      auto input = bench::make_input(160);
+      sha256 h;
+      byte digest[sha256::digest_size];
+      for (uint64_t i = 0; i < n; ++i) {
+         h.update(input.data(), 128);
+         h.update(input.data() + 128, 32);
+         h.final(digest);
+         bench::do_not_optimize(digest);
+      }
+   });
+
+   bench::add("sha256/prefix+suffix fork", 160, [](uint64_t n) {
+      auto input = bench::make_input(160);
+      sha256 prefix;
+      prefix.update(input.data(), 128);
+      byte digest[sha256::digest_size];
+      for (uint64_t i = 0; i < n; ++i) {
+         sha256 h = prefix;
+         h.update(input.data() + 128, 32);
+         h.final(digest);
+         bench::do_not_optimize(digest);
+      }
+   });
+
+   bench::add("sha256/prefix+suffix midstate", 160, [](uint64_t n) {
+      auto input = bench::make_input(160);
+      sha256 prefix;
+      prefix.update(input.data(), 128);
+      const auto m = prefix.midstate();
+      sha256 h;
+      byte digest[sha256::digest_size];
+      for (uint64_t i = 0; i < n; ++i) {
+         h.init(m);
+         h.update(input.data() + 128, 32);
+         h.final(digest);
+         bench::do_not_optimize(digest);
+      }
+   });
+}
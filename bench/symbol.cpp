@@ -0,0 +1,209 @@
+#include "bench.hpp"
+
+#include <eostd/crypto/xxhash.hpp>
+#include <eostd/flat_map.hpp>
+#include <eostd/symbol.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+
+using namespace eostd;
+using namespace eostd::literals;
+
+static_assert("EOS@eosio.token"_xsym == extended_symbol_code(symbol_code("EOS"), name("eosio.token")));
+static_assert("ABCDEFG@zzzzzzzzzzzzj"_xsym == extended_symbol_code(symbol_code("ABCDEFG"), name("zzzzzzzzzzzzj")));
+static_assert(!extended_symbol_code() && "A@a"_xsym);
+
+namespace {
+
+   constexpr xsym_error parse_error(std::string_view str) {
+      extended_symbol_code out;
+      return extended_symbol_code::try_parse(str, out);
+   }
+
+   static_assert(parse_error("EOS.eosio.token") == xsym_error::missing_separator);
+   static_assert(parse_error("ABCDEFGHIJ") == xsym_error::missing_separator);
+   static_assert(parse_error("ABCDEFGHIJ@eosio") == xsym_error::invalid_code);
+   static_assert(parse_error("@eosio.token") == xsym_error::invalid_code);
+   static_assert(parse_error("ABCDEFGH@eosio") == xsym_error::invalid_code);
+   static_assert(parse_error("EoS@eosio") == xsym_error::invalid_code);
+   static_assert(parse_error("EOS@") == xsym_error::invalid_contract);
+   static_assert(parse_error("EOS@eosio@token") == xsym_error::invalid_contract);
+   static_assert(parse_error("EOS@Eosio") == xsym_error::invalid_contract);
+   static_assert(parse_error("EOS@zzzzzzzzzzzzk") == xsym_error::invalid_contract);
+   static_assert(parse_error("EOS@zzzzzzzzzzzzzz") == xsym_error::invalid_contract);
+
+   /// `count` distinct token pairs, spread over a handful of token contracts
+   std::vector<extended_symbol_code> make_pairs(size_t count, uint8_t seed = 0) {
+      const char* contracts[] = { "eosio.token", "tethertether", "btc.ptokens", "vigortoken11", "dappservices" };
+      auto input = bench::make_input(count * 7, seed);
+      std::vector<extended_symbol_code> pairs;
+      std::map<extended_symbol_code, bool> seen;
+      for (size_t i = 0; pairs.size() < count; ++i) {
+         char code[7];
+         size_t length = 3 + input[(i * 7) % input.size()] % 4;
+         for (size_t k = 0; k < length; ++k)
+            code[k] = 'A' + input[(i * 7 + k + 1) % input.size()] % 26;
+         extended_symbol_code pair(symbol_code(std::string_view(code, length)), name(contracts[i % 5]));
+         if (seen.emplace(pair, true).second)
+            pairs.push_back(pair);
+      }
+      return pairs;
+   }
+
+   // flat_map has to hold exactly what std::map holds through inserts and erases
+   void verify_flat_map() {
+      auto pairs = make_pairs(500, 1);
+      flat_map<extended_symbol_code, uint32_t> fm;
+      std::map<extended_symbol_code, uint32_t> m;
+      auto ops = bench::make_input(20000, 2);
+      for (size_t i = 0; i + 1 < ops.size(); i += 2) {
+         const auto& key = pairs[(ops[i] << 8 | ops[i + 1]) % pairs.size()];
+         if (ops[i] & 1) {
+            fm[key] = i;
+            m[key] = i;
+         } else if (fm.erase(key) != m.erase(key)) {
+            std::fprintf(stderr, "flat_map erase mismatch at op %zu\n", i);
+            std::abort();
+         }
+      }
+
+      size_t visited = 0;
+      for (const auto& e : fm) {
+         auto it = m.find(e.first);
+         if (it == m.end() || it->second != e.second) {
+            std::fprintf(stderr, "flat_map holds an entry std::map does not\n");
+            std::abort();
+         }
+         ++visited;
+      }
+      if (visited != m.size() || fm.size() != m.size()) {
+         std::fprintf(stderr, "flat_map size mismatch: %zu vs %zu\n", fm.size(), m.size());
+         std::abort();
+      }
+
+      // a full map grows on the next new key, never on finding one it holds
+      flat_map<extended_symbol_code, uint32_t> full;
+      while (full.size() < 6)
+         full[pairs[full.size()]] = 0;
+      const uint32_t* first = &full.find(pairs[0])->second;
+      full[pairs[0]] = 1;
+      full.emplace(pairs[5], 2);
+      full.insert({ pairs[3], 3 });
+      if (&full[pairs[0]] != first || full.size() != 6 || full[pairs[5]] != 0) {
+         std::fprintf(stderr, "flat_map moved its entries on a lookup of an existing key\n");
+         std::abort();
+      }
+      full[pairs[6]] = 6;
+      if (full.size() != 7 || full[pairs[0]] != 1 || full[pairs[6]] != 6) {
+         std::fprintf(stderr, "flat_map lost entries growing\n");
+         std::abort();
+      }
+   }
+
+   /// the pair parsed the way the constructor used to: split at '@', then build each half
+   extended_symbol_code parse_by_parts(std::string_view str) {
+      auto at_pos = str.find('@');
+      eosio::check(at_pos != std::string_view::npos, "extended symbol should contain '@'");
+      return extended_symbol_code(symbol_code(str.substr(0, at_pos)), name(str.substr(at_pos + 1)));
+   }
+
+   // the single-pass parser has to agree with symbol_code and name on every valid pair
+   void verify_parse() {
+      for (const auto& pair : make_pairs(500, 3)) {
+         for (auto contract : { pair.contract, name("a"), name("zzzzzzzzzzzzj"), name("1.5.a.z") }) {
+            const std::string str = pair.code.to_string() + "@" + contract.to_string();
+            extended_symbol_code out;
+            if (extended_symbol_code::try_parse(str, out) != xsym_error::none || out != parse_by_parts(str)) {
+               std::fprintf(stderr, "extended_symbol_code parse mismatch for %s\n", str.c_str());
+               std::abort();
+            }
+         }
+      }
+   }
+
+   std::vector<std::string> make_strings(size_t count) {
+      std::vector<std::string> strings;
+      for (const auto& pair : make_pairs(count))
+         strings.push_back(pair.to_string());
+      return strings;
+   }
+
+}
+
+EOSTD_BENCHMARKS(symbol_benchmarks) {
+   verify_flat_map();
+   verify_parse();
+
+   bench::add("xsym/parse", 0, [](uint64_t n) {
+      auto strings = make_strings(64);
+      for (uint64_t i = 0; i < n; ++i) {
+         extended_symbol_code out;
+         bench::do_not_optimize(extended_symbol_code::try_parse(strings[i & 63], out));
+         bench::do_not_optimize(out);
+      }
+   });
+
+   bench::add("xsym/parse (split at '@')", 0, [](uint64_t n) {
+      auto strings = make_strings(64);
+      for (uint64_t i = 0; i < n; ++i)
+         bench::do_not_optimize(parse_by_parts(strings[i & 63]));
+   });
+
+   bench::add("xsym/std::hash", 16, [](uint64_t n) {
+      auto pairs = make_pairs(64);
+      std::hash<extended_symbol_code> h;
+      for (uint64_t i = 0; i < n; ++i)
+         bench::do_not_optimize(h(pairs[i & 63]));
+   });
+
+   bench::add("xsym/xxh64_hash", 16, [](uint64_t n) {
+      auto pairs = make_pairs(64);
+      xxh64_hash h;
+      for (uint64_t i = 0; i < n; ++i)
+         bench::do_not_optimize(h(pairs[i & 63]));
+   });
+
+   for (size_t count : {50, 300}) {
+      const std::string suffix = " (" + std::to_string(count) + " pairs)";
+
+      bench::add("xsym/flat_map find" + suffix, 0, [count](uint64_t n) {
+         auto pairs = make_pairs(count);
+         flat_map<extended_symbol_code, uint64_t> fm;
+         for (size_t i = 0; i < count; ++i)
+            fm[pairs[i]] = i;
+         for (uint64_t i = 0; i < n; ++i)
+            bench::do_not_optimize(fm.find(pairs[i % count])->second);
+      });
+
+      bench::add("xsym/std::map find" + suffix, 0, [count](uint64_t n) {
+         auto pairs = make_pairs(count);
+         std::map<extended_symbol_code, uint64_t> m;
+         for (size_t i = 0; i < count; ++i)
+            m[pairs[i]] = i;
+         for (uint64_t i = 0; i < n; ++i)
+            bench::do_not_optimize(m.find(pairs[i % count])->second);
+      });
+
+      bench::add("xsym/flat_map build" + suffix, 0, [count](uint64_t n) {
+         auto pairs = make_pairs(count);
+         for (uint64_t i = 0; i < n; ++i) {
+            flat_map<extended_symbol_code, uint64_t> fm;
+            for (size_t k = 0; k < count; ++k)
+               fm[pairs[k]] = k;
+            bench::do_not_optimize(fm.size());
+         }
+      });
+
+      bench::add("xsym/std::map build" + suffix, 0, [count](uint64_t n) {
+         auto pairs = make_pairs(count);
+         for (uint64_t i = 0; i < n; ++i) {
+            std::map<extended_symbol_code, uint64_t> m;
+            for (size_t k = 0; k < count; ++k)
+               m[pairs[k]] = k;
+            bench::do_not_optimize(m.size());
+         }
+      });
+   }
+}
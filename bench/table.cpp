@@ -0,0 +1,694 @@
+#include "bench.hpp"
+
+#include <eostd/deferred_multi_index_wrapper.hpp>
+#include <eostd/digest_multi_index_wrapper.hpp>
+#include <eostd/multi_index_wrapper.hpp>
+#include <eostd/native/db.hpp>
+#include <eosio/singleton.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+using namespace eostd;
+
+namespace {
+
+   struct account {
+      uint64_t id;
+      uint64_t owner;
+      uint64_t balance;
+
+      uint64_t primary_key()const { return id; }
+      uint64_t by_owner()const { return owner; }
+
+      EOSLIB_SERIALIZE(account, (id)(owner)(balance))
+   };
+
+   using accounts = eosio::multi_index<"accounts"_n, account,
+      eosio::indexed_by<"owner"_n, eosio::const_mem_fun<account, uint64_t, &account::by_owner>>>;
+
+   using by_id    = multi_index_wrapper<accounts>;
+   using by_owner = multi_index_wrapper<accounts, "owner"_n>;
+
+   using deferred_by_id    = deferred_multi_index_wrapper<accounts>;
+   using deferred_by_owner = deferred_multi_index_wrapper<accounts, "owner"_n>;
+
+   template<typename Hash>
+   using digest_by_id    = digest_multi_index_wrapper<accounts, "digest"_n, Hash>;
+   template<typename Hash>
+   using digest_by_owner = digest_multi_index_wrapper<accounts, "digest"_n, Hash, "owner"_n>;
+
+   using sha256_by_id = digest_multi_index_wrapper<accounts, "digestsha"_n, sha256_row_hash>;
+
+   constexpr name self = "eostd"_n;
+
+   /// rows a contract would walk in one action before paging
+   constexpr uint64_t rows_per_action = 1000;
+
+   /// point reads or writes in one action
+   constexpr uint64_t ops_per_action = 100;
+
+   /// helper functions of one action that each open the table they read
+   constexpr uint64_t helpers_per_action = 5;
+
+   /// owners are distinct and ordered differently from ids
+   uint64_t owner_of(uint64_t id) { return id * 0x9E3779B97F4A7C15ULL; }
+
+   uint64_t next_random(uint64_t& x) {
+      x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+      return x;
+   }
+
+   /// fills scope `rows` with that many accounts, once
+   void populate(uint64_t rows) {
+      static std::set<uint64_t> filled;
+      if (!filled.insert(rows).second)
+         return;
+      native::db_begin_action(self);
+      accounts tbl(self, rows);
+      for (uint64_t i = 0; i < rows; ++i)
+         tbl.emplace(self, [&](auto& a) { a.id = i; a.owner = owner_of(i); a.balance = i; });
+      native::db_begin_action(self);
+   }
+
+   void fail(const char* what, uint64_t got, uint64_t expected) {
+      std::fprintf(stderr, "table %s: got %llu, expected %llu\n", what,
+         static_cast<unsigned long long>(got), static_cast<unsigned long long>(expected));
+      std::abort();
+   }
+
+   // both indexes have to come back complete and in order, and stepping the secondary
+   // index without reading rows has to cost one db call per step
+   void verify_table() {
+      constexpr uint64_t rows = 100;
+      populate(rows);
+
+      native::db_begin_action(self);
+      uint64_t count = 0, last = 0;
+      by_id all(self, name(rows));
+      for (const auto& a : all.range()) {
+         if (a.id != count)
+            fail("primary scan id", a.id, count);
+         ++count;
+      }
+      if (count != rows)
+         fail("primary scan rows", count, rows);
+
+      native::db_begin_action(self);
+      count = 0;
+      by_owner all_owners(self, name(rows));
+      for (const auto& a : all_owners.range()) {
+         if (count && a.owner <= last)
+            fail("secondary scan order", a.owner, last);
+         last = a.owner;
+         ++count;
+      }
+      if (count != rows)
+         fail("secondary scan rows", count, rows);
+
+      native::db_begin_action(self);
+      by_owner w(self, name(rows));
+      for (uint64_t i = 1; i < rows; ++i)
+         ++w;
+      const auto& calls = native::db_action_calls();
+      if (calls[native::db_intrinsic::db_idx64_next] != rows - 1 || calls.total() != rows)
+         fail("secondary walk db calls", calls.total(), rows);
+   }
+
+   void expect_calls(const char* what, native::db_intrinsic intrinsic, uint64_t expected) {
+      const uint64_t got = native::db_action_calls()[intrinsic];
+      if (got != expected) {
+         std::fprintf(stderr, "table %s: %llu %s calls, expected %llu\n", what, static_cast<unsigned long long>(got),
+            native::to_string(intrinsic), static_cast<unsigned long long>(expected));
+         std::abort();
+      }
+   }
+
+   /// one helper of an action, reading a balance through a wrapper of its own
+   uint64_t balance_of(name scope, uint64_t id) { return by_id(self, scope, id)->balance; }
+
+   /// the same helper on the shared table of the scope
+   uint64_t balance_of_shared(name scope, uint64_t id) { return by_id(shared_table, self, scope, id)->balance; }
+
+   // helpers that each open a shared wrapper on the same scope share one table and the
+   // rows it has loaded, so the row is read from the db once instead of once per helper
+   void verify_table_cache() {
+      using native::db_intrinsic;
+      constexpr uint64_t rows = 100;
+      const name scope(rows);
+      populate(rows);
+
+      native::db_begin_action(self);
+      for (uint64_t k = 0; k < helpers_per_action; ++k)
+         if (balance_of_shared(scope, 42) != 42)
+            fail("shared helper balance", balance_of_shared(scope, 42), 42);
+      const auto& stats = table_cache_counters();
+      if (stats.hits != helpers_per_action - 1 || stats.misses != 1)
+         fail("table_cache hits", stats.hits, helpers_per_action - 1);
+      // a load gets the row's size, then the row
+      expect_calls("shared helpers", db_intrinsic::db_find_i64, 1);
+      expect_calls("shared helpers", db_intrinsic::db_get_i64, 2);
+      if (native::db_action_calls().total() != 3)
+         fail("shared helpers db calls", native::db_action_calls().total(), 3);
+
+      native::db_begin_action(self);
+      for (uint64_t k = 0; k < helpers_per_action; ++k)
+         if (balance_of(scope, 42) != 42)
+            fail("unshared helper balance", balance_of(scope, 42), 42);
+      if (stats.hits != 0 || stats.misses != 0)
+         fail("unshared helpers table_cache lookups", stats.hits + stats.misses, 0);
+      expect_calls("unshared helpers", db_intrinsic::db_find_i64, helpers_per_action);
+      if (native::db_action_calls().total() != 3 * helpers_per_action)
+         fail("unshared helpers db calls", native::db_action_calls().total(), 3 * helpers_per_action);
+   }
+
+   // wrappers look their key up only when the position is first needed, and not at all
+   // when made with no_lookup
+   void verify_lazy_lookup() {
+      using native::db_intrinsic;
+      constexpr uint64_t rows = 100;
+      const name scope(rows);
+      populate(rows);
+
+      native::db_begin_action(self);
+      by_id id(self, scope, 5);
+      by_owner owner(self, scope, owner_of(7));
+      id.table();
+      owner.get_index<"owner"_n>();
+      if (native::db_action_calls().total() != 0)
+         fail("wrapper construction db calls", native::db_action_calls().total(), 0);
+
+      if (!id || !owner)
+         fail("lazy lookup found rows", 0, 2);
+      expect_calls("lazy primary lookup", db_intrinsic::db_find_i64, 1);
+      expect_calls("lazy secondary lookup", db_intrinsic::db_idx64_find_secondary, 1);
+      if (id->balance != 5 || owner->id != 7)
+         fail("lazy lookup row", id->balance, 5);
+
+      // modify looks the row up by itself
+      native::db_begin_action(self);
+      by_id(self, scope, 9).modify(self, [](auto& a) { a.balance += rows; });
+      by_owner(self, scope, owner_of(9)).modify(self, [](auto& a) { a.balance -= rows; });
+      if (by_id(self, scope, 9)->balance != 9)
+         fail("lazy modify balance", by_id(self, scope, 9)->balance, 9);
+
+      native::db_begin_action(self);
+      by_id missing(self, scope, rows);
+      if (missing.exists())
+         fail("lazy lookup of a missing row", missing->id, rows);
+
+      // emplace-only wrappers only store
+      native::db_begin_action(self);
+      by_id created(self, scope, no_lookup);
+      by_owner created_owner(self, scope, no_lookup);
+      if (created || created_owner)
+         fail("no_lookup wrapper exists", 1, 0);
+      created.emplace(self, [&](auto& a) { a.id = rows; a.owner = owner_of(rows); a.balance = 0; });
+      created_owner.emplace(self, [&](auto& a) { a.id = rows + 1; a.owner = owner_of(rows + 1); a.balance = 0; });
+      expect_calls("no_lookup emplace", db_intrinsic::db_find_i64, 0);
+      expect_calls("no_lookup emplace", db_intrinsic::db_idx64_find_secondary, 0);
+      expect_calls("no_lookup emplace", db_intrinsic::db_store_i64, 2);
+      if (native::db_action_calls().total() != 4)
+         fail("no_lookup emplace db calls", native::db_action_calls().total(), 4);
+      created.erase();
+      created_owner.erase();
+   }
+
+   /// expects the row stores, updates and removes made so far in this action
+   void expect_writes(const char* what, uint64_t stores, uint64_t updates, uint64_t removes) {
+      expect_calls(what, native::db_intrinsic::db_store_i64, stores);
+      expect_calls(what, native::db_intrinsic::db_update_i64, updates);
+      expect_calls(what, native::db_intrinsic::db_remove_i64, removes);
+   }
+
+   // deferred wrappers write their row at most once, when they commit, move to another
+   // row or go out of scope
+   void verify_deferred() {
+      constexpr uint64_t rows = 500;
+      const name scope(rows);
+      populate(rows);
+
+      // modify, modify, ... is one update, made on scope exit
+      native::db_begin_action(self);
+      {
+         deferred_by_id w(self, scope, 3);
+         for (uint64_t i = 0; i < 5; ++i)
+            w.modify(self, [](auto& a) { ++a.balance; });
+         if (!w.dirty() || w->balance != 8)
+            fail("deferred modify pending balance", w->balance, 8);
+         expect_writes("deferred modify before scope exit", 0, 0, 0);
+      }
+      expect_writes("deferred modify x5", 0, 1, 0);
+      if (by_id(self, scope, 3)->balance != 8)
+         fail("deferred modify balance", by_id(self, scope, 3)->balance, 8);
+
+      // and on a step to another row, here on the owner index
+      native::db_begin_action(self);
+      {
+         deferred_by_owner w(self, scope, owner_of(4));
+         w.modify(self, [](auto& a) { a.balance = 0; });
+         w.modify(self, [](auto& a) { a.balance = 4; });
+         ++w;
+         expect_writes("deferred modify then step", 0, 1, 0);
+         if (w.dirty())
+            fail("deferred wrapper dirty after step", 1, 0);
+      }
+
+      // emplace followed by modifies is one store
+      native::db_begin_action(self);
+      {
+         deferred_by_id w(self, scope, no_lookup);
+         w.emplace(self, [&](auto& a) { a.id = rows; a.owner = owner_of(rows); a.balance = 0; });
+         w.modify(self, [](auto& a) { a.balance = 7; });
+         w.modify(self, [](auto& a) { ++a.balance; });
+         w.commit();
+         expect_writes("deferred emplace+modify", 1, 0, 0);
+      }
+      // the row and its owner index entry, and nothing more on scope exit
+      if (native::db_action_calls().total() != 2)
+         fail("deferred emplace+modify db calls", native::db_action_calls().total(), 2);
+      if (by_id(self, scope, rows)->balance != 8)
+         fail("deferred emplace+modify balance", by_id(self, scope, rows)->balance, 8);
+
+      // modify followed by erase is one remove
+      native::db_begin_action(self);
+      {
+         deferred_by_id w(self, scope, rows);
+         w.modify(self, [](auto& a) { ++a.balance; });
+         w.erase();
+      }
+      expect_writes("deferred modify+erase", 0, 0, 1);
+      if (by_id(self, scope, rows))
+         fail("deferred modify+erase left the row", rows, 0);
+
+      // emplace followed by erase is nothing at all
+      native::db_begin_action(self);
+      {
+         deferred_by_id w(self, scope, no_lookup);
+         w.emplace(self, [&](auto& a) { a.id = rows; a.owner = owner_of(rows); a.balance = 0; });
+         w.erase();
+      }
+      if (native::db_action_calls().total() != 0)
+         fail("deferred emplace+erase db calls", native::db_action_calls().total(), 0);
+
+      // a helper called while a write is held back opens its own wrapper on the table and
+      // reads the row as held, which makes the write then; wrappers opened before the
+      // write see it too, when they first read the table after it
+      native::db_begin_action(self);
+      {
+         by_id before(self, scope, 11);
+         deferred_by_id w(self, scope, 11);
+         w.modify(self, [](auto& a) { a.balance = rows; });
+         if (balance_of(scope, 11) != rows)
+            fail("helper read of a held write", balance_of(scope, 11), rows);
+         expect_writes("helper read of a held write", 0, 1, 0);
+         if (w.dirty() || before->balance != rows)
+            fail("earlier wrapper read of a held write", before->balance, rows);
+
+         // and so does a helper on the shared table
+         w.modify(self, [](auto& a) { a.balance = 0; });
+         if (balance_of_shared(scope, 11) != 0 || w.dirty())
+            fail("shared helper read of a held write", balance_of_shared(scope, 11), 0);
+
+         w.modify(self, [](auto& a) { a.balance = 11; });
+         deferred_by_id(self, scope, no_lookup).emplace(self, [&](auto& a) { a.id = rows + 1; a.owner = owner_of(rows + 1); a.balance = 0; });
+         if (w.dirty() || !by_id(self, scope, rows + 1))
+            fail("held writes made for another deferred wrapper", w.dirty(), 0);
+         expect_writes("held writes made for another deferred wrapper", 1, 3, 0);
+      }
+      if (by_id(self, scope, 11)->balance != 11)
+         fail("held write made on scope exit", by_id(self, scope, 11)->balance, 11);
+   }
+
+   // shared wrappers on one scope share its multi_index, so rows erased through one of them
+   // have to leave the others past the end, never on the freed row, and the rest where they were
+   void verify_shared_erase() {
+      constexpr uint64_t rows = 600;
+      const name scope(rows);
+      populate(rows);
+
+      native::db_begin_action(self);
+      by_id a(shared_table, self, scope, 5);
+      by_owner b(shared_table, self, scope, owner_of(6));
+      by_owner c(shared_table, self, scope, owner_of(7));
+      by_id d(shared_table, self, scope, 8);
+      by_owner e(shared_table, self, scope, owner_of(9));
+      by_id f(shared_table, self, scope, 10);
+      // c and e are on their index entries without having loaded their rows
+      if (a->balance != 5 || b->id != 6 || !c || d->id != 8 || !e || f->id != 10)
+         fail("shared wrapper rows", a->balance, 5);
+
+      by_id(shared_table, self, scope, 5).erase();
+      by_id(shared_table, self, scope, no_lookup).erase_range(6, 8);
+      if (a || b || c)
+         fail("wrappers on erased rows exist", 1, 0);
+      if (!d || d->id != 8 || (++d)->id != 9)
+         fail("primary wrapper after a peer erase", d ? d->id : 0, 9);
+      by_owner next(shared_table, self, scope, owner_of(9));
+      if (!e || e->id != 9 || (++e)->id != (++next)->id)
+         fail("secondary wrapper after a peer erase", e ? e->id : 0, next->id);
+
+      // a row erased and emplaced again is read from its new copy
+      by_id(shared_table, self, scope, 10).erase();
+      by_id(shared_table, self, scope, no_lookup).emplace(self, [&](auto& r) { r.id = 10; r.owner = owner_of(10); r.balance = rows; });
+      if (!f || f->balance != rows)
+         fail("wrapper on a row emplaced again", f ? f->balance : 0, rows);
+
+      by_owner(shared_table, self, scope, no_lookup).clear_scope(rows);
+      if (d || e || f)
+         fail("wrappers after a peer clear_scope", 1, 0);
+   }
+
+   template<typename Wrapper>
+   std::vector<uint64_t> ids(const Wrapper& w) {
+      std::vector<uint64_t> _ids;
+      for (const auto& a : w.range())
+         _ids.push_back(a.id);
+      return _ids;
+   }
+
+   // bulk erases walk the index once, keep to their budget and leave the wrapper on the
+   // first row they did not visit
+   void verify_bulk_erase() {
+      using native::db_intrinsic;
+      constexpr uint64_t rows = 300;
+      const name scope(rows);
+      populate(rows);
+
+      native::db_begin_action(self);
+      by_id w(self, scope, no_lookup);
+      if (w.erase_range(10, 20) != 10 || !w || w->id != 20)
+         fail("primary erase_range", w ? w->id : 0, 20);
+      if (w.erase_range(0, 30, 5) != 5 || w->id != 5 || w.erase_range(0, 30) != 15 || w->id != 30)
+         fail("primary erase_range budget", w->id, 30);
+      if (ids(w).size() != rows - 30)
+         fail("primary erase_range rows", ids(w).size(), rows - 30);
+
+      // every third row of the next 60 visited
+      w.lower_bound(100);
+      if (w.erase_if([](const account& a) { return a.id % 3 == 0; }, 60) != 20 || w->id != 160)
+         fail("primary erase_if", w->id, 160);
+
+      native::db_begin_action(self);
+      std::vector<uint64_t> owners;
+      by_owner all_owners(self, scope);
+      for (const auto& a : all_owners.range())
+         owners.push_back(a.owner);
+      const uint64_t kept = owners.size();
+
+      native::db_begin_action(self);
+      by_owner o(self, scope, no_lookup);
+      if (o.erase_range(owners[20], owners[40], 15) != 15 || o->owner != owners[35])
+         fail("secondary erase_range budget", o->owner, owners[35]);
+      // one db call per row to step, the rest is multi_index erasing the row by value
+      expect_calls("secondary erase_range", db_intrinsic::db_idx64_next, 15);
+      expect_calls("secondary erase_range", db_intrinsic::db_next_i64, 0);
+      if (o.erase_range(owners[20], owners[40], 15) != 5 || o->owner != owners[40])
+         fail("secondary erase_range rest", o->owner, owners[40]);
+
+      o.lower_bound(owners[100]);
+      if (o.erase_if([](const account& a) { return a.balance % 2 == 0; }, 50) == 0 || o->owner != owners[150])
+         fail("secondary erase_if", o->owner, owners[150]);
+
+      native::db_begin_action(self);
+      const uint64_t left = ids(by_id(self, scope)).size();
+      if (left >= kept - 20)
+         fail("secondary erase rows", left, kept - 20);
+      by_owner c(self, scope, no_lookup);
+      if (c.clear_scope(100) != 100 || !c || c.clear_scope(left) != left - 100 || c)
+         fail("clear_scope", ids(c).size(), 0);
+      if (!ids(by_id(self, scope)).empty())
+         fail("clear_scope rows", ids(by_id(self, scope)).size(), 0);
+   }
+
+   /// the digest of a scope, hashed from a full scan independently of the wrapper
+   template<typename Hash>
+   table_digest<Hash::lanes> scan_digest(name scope) {
+      table_digest<Hash::lanes> digest;
+      uint64_t hash[Hash::lanes];
+      by_id all(self, scope);
+      for (const auto& a : all.range()) {
+         const auto packed = eosio::pack(a);
+         Hash::hash(reinterpret_cast<const byte*>(packed.data()), packed.size(), hash);
+         digest.add(hash);
+      }
+      return digest;
+   }
+
+   /// fills scope `rows` and makes the digest `Wrapper` keeps current, once
+   template<typename Wrapper>
+   void populate_digest(uint64_t rows) {
+      static std::set<uint64_t> digested;
+      populate(rows);
+      if (!digested.insert(rows).second)
+         return;
+      native::db_begin_action(self);
+      Wrapper(self, name(rows), no_lookup).recompute_digest();
+   }
+
+   // every write through the digest wrappers, single or bulk, on either index, has to leave
+   // the same digest a full rescan gives, readable as a plain singleton
+   template<typename Hash>
+   void verify_digest(uint64_t rows) {
+      const name scope(rows);
+      populate_digest<digest_by_id<Hash>>(rows);
+      uint64_t x = rows;
+
+      for (uint64_t round = 0; round < 20; ++round) {
+         native::db_begin_action(self);
+         for (uint64_t i = 0; i < 20; ++i) {
+            const uint64_t id = next_random(x) % (rows * 2);
+            switch (next_random(x) % 4) {
+               case 0: {
+                  digest_by_id<Hash> w(self, scope, id);
+                  if (!w)
+                     w.emplace(self, [&](auto& a) { a.id = id; a.owner = owner_of(id); a.balance = id; });
+                  break;
+               }
+               case 1: {
+                  digest_by_owner<Hash> w(self, scope, owner_of(id));
+                  if (w)
+                     w.modify(self, [&](auto& a) { a.balance += x % 1000; a.owner = ~a.owner; });
+                  break;
+               }
+               case 2: {
+                  digest_by_id<Hash> w(self, scope, id);
+                  if (w)
+                     w.erase();
+                  break;
+               }
+               default:
+                  digest_by_id<Hash>(self, scope, no_lookup).erase_range(id, id + 3);
+                  digest_by_owner<Hash> w(self, scope, no_lookup);
+                  w.lower_bound(owner_of(id));
+                  w.erase_if([](const account& a) { return a.balance % 5 == 0; }, 4);
+                  break;
+            }
+         }
+
+         native::db_begin_action(self);
+         const auto expected = scan_digest<Hash>(scope);
+         const auto digest = digest_by_id<Hash>(self, scope, no_lookup).digest();
+         if (digest != expected)
+            fail("digest rows", digest.rows, expected.rows);
+         if (eosio::singleton<"digest"_n, table_digest<Hash::lanes>>(self, scope.value).get() != expected)
+            fail("digest singleton rows", digest.rows, expected.rows);
+      }
+
+      native::db_begin_action(self);
+      digest_by_owner<Hash> w(self, scope, no_lookup);
+      w.clear_scope(rows * 2);
+      if (w.digest() != table_digest<Hash::lanes>{})
+         fail("digest after clear_scope", w.digest().rows, 0);
+   }
+
+   /// walks `n` rows in pages of rows_per_action, one action per page, wrapping around at the end
+   template<typename Wrapper, typename Next>
+   void add_scan(const std::string& index, uint64_t rows, Next next_key) {
+      bench::add("table/scan " + index + " (" + std::to_string(rows) + " rows)", 0, [rows, next_key](uint64_t n) {
+         const uint64_t calls = native::db_total_calls().total();
+         uint64_t from = 0, sum = 0;
+         while (n) {
+            native::db_begin_action(self);
+            uint64_t page = std::min(n, rows_per_action);
+            n -= page;
+            Wrapper w(self, name(rows));
+            for (const auto& a : w.range(from)) {
+               sum += a.balance;
+               from = next_key(a);
+               if (--page == 0)
+                  break;
+            }
+            if (page) {
+               n += page;
+               from = 0;
+            }
+         }
+         bench::do_not_optimize(sum);
+         bench::count(native::db_total_calls().total() - calls);
+      }, [rows] { populate(rows); });
+   }
+
+   /// runs `op` on `n` random rows, ops_per_action of them per action
+   template<typename Op>
+   void add_ops(const std::string& what, uint64_t rows, Op op, void (*prepare)(uint64_t) = populate) {
+      bench::add("table/" + what + " (" + std::to_string(rows) + " rows)", 0, [rows, op](uint64_t n) {
+         const uint64_t calls = native::db_total_calls().total();
+         uint64_t x = 0x9E3779B97F4A7C15ULL;
+         for (uint64_t i = 0; i < n; ++i) {
+            if (i % ops_per_action == 0)
+               native::db_begin_action(self);
+            op(name(rows), rows, next_random(x) % rows, i);
+         }
+         bench::count(native::db_total_calls().total() - calls);
+      }, [rows, prepare] { prepare(rows); });
+   }
+
+   /// runs `n` actions that each walk rows_per_action rows and then seek ops_per_action random ones
+   void add_scan_seek(const std::string& what, uint64_t rows, bool shared) {
+      bench::add("table/scan+seek, " + what + " (" + std::to_string(rows) + " rows)", 0, [rows, shared](uint64_t n) {
+         const uint64_t calls = native::db_total_calls().total();
+         uint64_t x = 0x9E3779B97F4A7C15ULL, sum = 0;
+         auto walk = [&sum](const by_id& w) {
+            for (const auto& a : w.range(0, rows_per_action))
+               sum += a.balance;
+         };
+         for (uint64_t i = 0; i < n; ++i) {
+            native::db_begin_action(self);
+            const name scope(rows);
+            if (shared)
+               walk(by_id(shared_table, self, scope));
+            else
+               walk(by_id(self, scope));
+            for (uint64_t k = 0; k < ops_per_action; ++k)
+               sum += shared ? balance_of_shared(scope, next_random(x) % rows) : balance_of(scope, next_random(x) % rows);
+         }
+         bench::do_not_optimize(sum);
+         bench::count(native::db_total_calls().total() - calls);
+      }, [rows] { populate(rows); });
+   }
+
+   /// runs `n` actions that call `helper` helpers_per_action times on one random row, counting `counter()` after each
+   template<typename Helper, typename Counter>
+   void add_helpers(const std::string& what, uint64_t rows, Helper helper, Counter counter) {
+      bench::add("table/helpers, " + what + " (" + std::to_string(rows) + " rows)", 0,
+         [rows, helper, counter](uint64_t n) {
+            uint64_t x = 0x9E3779B97F4A7C15ULL;
+            for (uint64_t i = 0; i < n; ++i) {
+               native::db_begin_action(self);
+               const uint64_t id = next_random(x) % rows;
+               for (uint64_t k = 0; k < helpers_per_action; ++k)
+                  bench::do_not_optimize(helper(name(rows), id));
+               bench::count(counter());
+            }
+         }, [rows] { populate(rows); });
+   }
+
+}
+
+EOSTD_BENCHMARKS(table_benchmarks) {
+   verify_table();
+   verify_table_cache();
+   verify_lazy_lookup();
+   verify_bulk_erase();
+   verify_shared_erase();
+   verify_deferred();
+   verify_digest<xxh64_row_hash>(400);
+   verify_digest<sha256_row_hash>(401);
+
+   for (uint64_t rows : { 1000, 10000, 100000, 1000000 }) {
+      add_scan<by_id>("primary", rows, [](const account& a) { return a.id + 1; });
+      add_scan<by_owner>("secondary", rows, [](const account& a) { return a.owner + 1; });
+
+      add_ops("seek primary", rows, [](name scope, uint64_t, uint64_t id, uint64_t) {
+         by_id w(self, scope, id);
+         bench::do_not_optimize(w->balance);
+      });
+
+      add_ops("seek secondary", rows, [](name scope, uint64_t, uint64_t id, uint64_t) {
+         by_owner w(self, scope, owner_of(id));
+         bench::do_not_optimize(w->balance);
+      });
+
+      // the count is db calls, or for the last row, table_cache hits, per action
+      add_helpers("own tables", rows, balance_of, [] { return native::db_action_calls().total(); });
+      add_helpers("table_cache", rows, balance_of_shared, [] { return native::db_action_calls().total(); });
+      add_helpers("cache hits", rows, balance_of_shared, [] { return uint64_t(table_cache_counters().hits); });
+
+      // seeks on a shared table search every row the walk loaded
+      add_scan_seek("own tables", rows, false);
+      add_scan_seek("shared", rows, true);
+
+      add_ops("modify", rows, [](name scope, uint64_t, uint64_t id, uint64_t) {
+         by_id w(self, scope, id);
+         w.modify(self, [](auto& a) { ++a.balance; });
+      });
+
+      add_ops("modify secondary key", rows, [](name scope, uint64_t, uint64_t id, uint64_t) {
+         // moves the row in the owner index and back, so later runs find it where it was
+         by_id w(self, scope, id);
+         w.modify(self, [](auto& a) { a.owner = ~a.owner; });
+         w.modify(self, [](auto& a) { a.owner = ~a.owner; });
+      });
+
+      add_ops("emplace+erase", rows, [](name scope, uint64_t rows, uint64_t, uint64_t i) {
+         by_id w(self, scope, rows + i);
+         w.emplace(self, [&](auto& a) { a.id = rows + i; a.owner = owner_of(rows + i); a.balance = 0; });
+         w.erase();
+      });
+
+      // both benches emplace a batch of rows and erase it again; the rows get owners above
+      // every other row's, so they are next to each other in the index
+      constexpr uint64_t batch = 10;
+      auto emplace_batch = [](name scope, uint64_t rows, uint64_t i) {
+         by_owner w(self, scope, no_lookup);
+         for (uint64_t k = 0; k < batch; ++k) {
+            const uint64_t id = rows + i * batch + k;
+            w.emplace(self, [&](auto& a) { a.id = id; a.owner = ~uint64_t(0) - batch + k; a.balance = 0; });
+         }
+      };
+
+      add_ops("erase 10 one by one", rows, [emplace_batch](name scope, uint64_t rows, uint64_t, uint64_t i) {
+         emplace_batch(scope, rows, i);
+         by_owner w(self, scope, no_lookup);
+         w.lower_bound(~uint64_t(0) - batch);
+         for (uint64_t k = 0; k < batch; ++k)
+            w.erase();
+      });
+
+      add_ops("erase_range 10", rows, [emplace_batch](name scope, uint64_t rows, uint64_t, uint64_t i) {
+         emplace_batch(scope, rows, i);
+         by_owner(self, scope, no_lookup).erase_range(~uint64_t(0) - batch, ~uint64_t(0));
+      });
+   }
+
+   // recomputing walks the whole table in one action, which the multi_index row cache
+   // makes quadratic, so digests are only benchmarked on the smaller tables
+   for (uint64_t rows : { 1000, 10000 }) {
+      add_ops("modify, xxh64 digest", rows, [](name scope, uint64_t, uint64_t id, uint64_t) {
+         digest_by_id<xxh64_row_hash> w(self, scope, id);
+         w.modify(self, [](auto& a) { ++a.balance; });
+      }, populate_digest<digest_by_id<xxh64_row_hash>>);
+
+      add_ops("modify, sha256 digest", rows, [](name scope, uint64_t, uint64_t id, uint64_t) {
+         sha256_by_id w(self, scope, id);
+         w.modify(self, [](auto& a) { ++a.balance; });
+      }, populate_digest<sha256_by_id>);
+
+      add_ops("digest read", rows, [](name scope, uint64_t, uint64_t, uint64_t) {
+         bench::do_not_optimize(digest_by_id<xxh64_row_hash>(self, scope, no_lookup).digest().rows);
+      }, populate_digest<digest_by_id<xxh64_row_hash>>);
+
+      bench::add("table/digest recompute (" + std::to_string(rows) + " rows)", 0, [rows](uint64_t n) {
+         const uint64_t calls = native::db_total_calls().total();
+         for (uint64_t i = 0; i < n; ++i) {
+            native::db_begin_action(self);
+            bench::do_not_optimize(digest_by_id<xxh64_row_hash>(self, name(rows), no_lookup).recompute_digest().rows);
+         }
+         bench::count(native::db_total_calls().total() - calls);
+      }, [rows] { populate(rows); });
+   }
+}
@@ -0,0 +1,145 @@
+#include "bench.hpp"
+
+#include <eostd/crypto/xxhash.hpp>
+#include <eostd/crypto/xxhash_constexpr.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace eostd;
+
+namespace {
+
+   // the constexpr hashes must match the runtime ones; vectors come from the reference implementation
+   template<size_t N>
+   constexpr std::array<char, N> make_sample() {
+      std::array<char, N> a{};
+      for (size_t i = 0; i < N; ++i)
+         a[i] = static_cast<char>(i * 7 + 3);
+      return a;
+   }
+
+   constexpr auto sample200 = make_sample<200>();
+   constexpr auto sample1500 = make_sample<1500>();
+
+   static_assert(ct::xxh32("") == 0x02cc5d05);
+   static_assert(ct::xxh32("abc") == 0x32d153ff);
+   static_assert(ct::xxh32("eosio.token") == 0x8f7eac6b);
+   static_assert(ct::xxh32("0123456789abcdef0123456789abcdef0") == 0x5c28f38d);
+   static_assert(ct::xxh32(sample200.data(), sample200.size(), 5) == 0x923c9fd2);
+   static_assert(ct::xxh32(sample1500.data(), sample1500.size(), 5) == 0x7e884550);
+
+   static_assert(ct::xxh64("") == 0xef46db3751d8e999);
+   static_assert(ct::xxh64("a") == 0xd24ec4f1a98c6e5b);
+   static_assert(ct::xxh64("eosio.token") == 0x7574b445ea8a4506);
+   static_assert(ct::xxh64("0123456789abcdef0123456789abcdef0") == 0xe87684f08d6d0816);
+   static_assert(ct::xxh64(sample200.data(), sample200.size(), 5) == 0x7f35b94f6dcd7af7);
+   static_assert(ct::xxh64(sample1500.data(), sample1500.size(), 5) == 0x3c265f5d4a5241db);
+
+   static_assert(ct::xxh3_64("") == 0x2d06800538d394c2);
+   static_assert(ct::xxh3_64("a") == 0xe6c632b61e964e1f);
+   static_assert(ct::xxh3_64("abc") == 0x78af5f94892f3950);
+   static_assert(ct::xxh3_64("eosio.token") == 0x9e58d876dcee6f09);
+   static_assert(ct::xxh3_64("0123456789abcdef0123456789abcdef0") == 0x743a608ef1f0f535);
+   static_assert(ct::xxh3_64(sample200.data(), sample200.size()) == 0x746cd0025327bf5b);
+   static_assert(ct::xxh3_64(sample200.data(), sample200.size(), 5) == 0x0314bf53ba12e317);
+   static_assert(ct::xxh3_64(sample1500.data(), sample1500.size()) == 0x636eb3103aa644e2);
+   static_assert(ct::xxh3_64(sample1500.data(), sample1500.size(), 5) == 0x8099bd89f63ccf8f);
+
+   // the incremental states, fed in pieces, must agree with the one-shot functions
+   void verify_xxh_states() {
+      for (size_t size : {0, 1, 7, 8, 16, 31, 64, 129, 240, 241, 1000}) {
+         auto input = bench::make_input(size);
+         auto data = reinterpret_cast<const char*>(input.data());
+
+         xxh32_state s32(7);
+         xxh64_state s64(7);
+         xxh3_64_state s3(7);
+         xxh3_128_state s128(7);
+         for (size_t i = 0; i < size; i += 5) {
+            uint32_t n = std::min<size_t>(5, size - i);
+            s32.update(data + i, n);
+            s64.update(data + i, n);
+            s3.update(data + i, n);
+            s128.update(data + i, n);
+         }
+
+         if (s32.digest() != xxh32(data, size, 7) || s64.digest() != xxh64(data, size, 7) ||
+             s3.digest() != xxh3_64(data, size, 7) || s128.digest() != xxh3_128(data, size, 7)) {
+            std::fprintf(stderr, "incremental xxhash mismatch: %zu bytes\n", size);
+            std::abort();
+         }
+         if (ct::xxh32(data, size, 7) != xxh32(data, size, 7) || ct::xxh64(data, size, 7) != xxh64(data, size, 7) ||
+             ct::xxh3_64(data, size, 7) != xxh3_64(data, size, 7)) {
+            std::fprintf(stderr, "constexpr xxhash mismatch: %zu bytes\n", size);
+            std::abort();
+         }
+      }
+   }
+
+}
+
+EOSTD_BENCHMARKS(xxhash_benchmarks) {
+   verify_xxh_states();
+
+   for (size_t size : {8, 16, 32, 64, 128, 256, 4096}) {
+      bench::add("xxh32", size, [size](uint64_t n) {
+         auto input = bench::make_input(size);
+         auto data = reinterpret_cast<const char*>(input.data());
+         for (uint64_t i = 0; i < n; ++i) {
+            bench::do_not_optimize(xxh32(data, size));
+         }
+      });
+
+      bench::add("xxh64", size, [size](uint64_t n) {
+         auto input = bench::make_input(size);
+         auto data = reinterpret_cast<const char*>(input.data());
+         for (uint64_t i = 0; i < n; ++i) {
+            bench::do_not_optimize(xxh64(data, size));
+         }
+      });
+
+      bench::add("xxh3_64", size, [size](uint64_t n) {
+         auto input = bench::make_input(size);
+         auto data = reinterpret_cast<const char*>(input.data());
+         for (uint64_t i = 0; i < n; ++i) {
+            bench::do_not_optimize(xxh3_64(data, size));
+         }
+      });
+
+      bench::add("xxh3_128", size, [size](uint64_t n) {
+         auto input = bench::make_input(size);
+         auto data = reinterpret_cast<const char*>(input.data());
+         for (uint64_t i = 0; i < n; ++i) {
+            bench::do_not_optimize(xxh3_128(data, size));
+         }
+      });
+   }
+
+   // a table key made of three fields, hashed field by field
+   struct key { uint64_t contract; uint64_t code; uint32_t kind; };
+
+   bench::add("xxh64_state/3 fields", 20, [](uint64_t n) {
+      key k{0x5530ea033c80a555, 0x534f45, 3};
+      for (uint64_t i = 0; i < n; ++i) {
+         xxh64_state s;
+         s.update(k.contract);
+         s.update(k.code);
+         s.update(k.kind);
+         bench::do_not_optimize(s.digest());
+      }
+   });
+
+   bench::add("xxh3_64_state/3 fields", 20, [](uint64_t n) {
+      key k{0x5530ea033c80a555, 0x534f45, 3};
+      for (uint64_t i = 0; i < n; ++i) {
+         xxh3_64_state s;
+         s.update(k.contract);
+         s.update(k.code);
+         s.update(k.kind);
+         bench::do_not_optimize(s.digest());
+      }
+   });
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace eostd {
+
+   /**
+    * Monotonic allocator over a caller-provided block, reset between actions
+    *
+    * Allocation bumps a pointer and freeing is a no-op, except that the most recent
+    * allocation can be given back. reset() makes the whole block available again, so
+    * buffers that would each take a fresh chunk of the contract heap reuse the same
+    * memory instead. When the block is full, allocations spill to the heap and are
+    * freed normally.
+    *
+    * Nothing allocated from the arena may be used after reset().
+    */
+   class byte_arena {
+   public:
+      byte_arena(void* buffer, size_t size)
+      : _begin(static_cast<unsigned char*>(buffer)), _end(_begin + size), _top(_begin)
+      {}
+
+      byte_arena(const byte_arena&) = delete;
+      byte_arena& operator=(const byte_arena&) = delete;
+
+      void* allocate(size_t size, size_t align = 1) {
+         const size_t _pad = (0 - reinterpret_cast<uintptr_t>(_top)) & (align - 1);
+         if (_pad + size > static_cast<size_t>(_end - _top)) {
+            ++_spills;
+            return ::operator new(size);
+         }
+         auto _p = _top + _pad;
+         _top = _p + size;
+         if (used() > _high_water)
+            _high_water = used();
+         return _p;
+      }
+
+      void deallocate(void* p, size_t size) {
+         if (!owns(p))
+            ::operator delete(p);
+         else if (static_cast<unsigned char*>(p) + size == _top)
+            _top = static_cast<unsigned char*>(p);
+      }
+
+      bool owns(const void* p)const {
+         const auto _a = reinterpret_cast<uintptr_t>(p);
+         return _a >= reinterpret_cast<uintptr_t>(_begin) && _a < reinterpret_cast<uintptr_t>(_end);
+      }
+
+      /// makes the whole block available again
+      void reset() { _top = _begin; }
+
+      size_t capacity()const { return _end - _begin; }
+      size_t used()const { return _top - _begin; }
+      size_t high_water()const { return _high_water; }   ///< most bytes in use at once
+      uint32_t spills()const { return _spills; }         ///< allocations that went to the heap
+
+   private:
+      unsigned char* _begin;
+      unsigned char* _end;
+      unsigned char* _top;
+      size_t         _high_water = 0;
+      uint32_t       _spills = 0;
+   };
+
+   /**
+    * byte_arena with its own block
+    *
+    * Contract stacks are small, so a large one is better declared static and reset at the
+    * start of each action than put on the stack.
+    */
+   template<size_t Size>
+   class inline_arena : public byte_arena {
+   public:
+      inline_arena() : byte_arena(_buffer, Size) {}
+
+   private:
+      alignas(std::max_align_t) unsigned char _buffer[Size];
+   };
+
+}
@@ -2,10 +2,22 @@
 
 #include <eosio/binary_extension.hpp>
 
+#include <string_view>
+
 namespace eostd {
 
+/**
+ * binary_extension that deserializes straight into its own storage
+ *
+ * `binary_extension<std::string_view>` is a view mode for payloads serialized as
+ * `std::vector<char>` or `std::string`, which share a wire format. It points into the
+ * buffer being deserialized instead of copying out of it, so it is only valid while
+ * that buffer is, e.g. for the rest of the action that unpacked it.
+ */
 template<typename T>
 class binary_extension : public eosio::binary_extension<T> {
+public:
+   using eosio::binary_extension<T>::binary_extension;
 };
 
 }
@@ -15,7 +27,7 @@ namespace eosio {
 template<typename DataStream, typename T>
 inline DataStream& operator<<(DataStream& ds, const eostd::binary_extension<T>& be) {
    if (be) {
-      ds << be.value_or();
+      ds << *be;
    }
    return ds;
 }
@@ -23,9 +35,28 @@ inline DataStream& operator<<(DataStream& ds, const eostd::binary_extension<T>&
 template<typename DataStream, typename T>
 inline DataStream& operator>>(DataStream& ds, eostd::binary_extension<T>& be) {
    if (ds.remaining()) {
-      T val;
-      ds >> val;
-      be.emplace(val);
+      ds >> be.emplace();
+   }
+   return ds;
+}
+
+template<typename DataStream>
+inline DataStream& operator<<(DataStream& ds, const eostd::binary_extension<std::string_view>& be) {
+   if (be) {
+      ds << unsigned_int{static_cast<uint32_t>(be->size())};
+      ds.write(be->data(), be->size());
+   }
+   return ds;
+}
+
+template<typename DataStream>
+inline DataStream& operator>>(DataStream& ds, eostd::binary_extension<std::string_view>& be) {
+   if (ds.remaining()) {
+      unsigned_int size;
+      ds >> size;
+      check(ds.remaining() >= size.value, "datastream attempted to read past the end");
+      be.emplace(ds.pos(), size.value);
+      ds.skip(size.value);
    }
    return ds;
 }
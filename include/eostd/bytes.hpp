@@ -1,11 +1,165 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <utility>
 #include <vector>
 
+#include "arena.hpp"
+#include "span.hpp"
+
 namespace eostd {
 
 using byte = uint8_t;
 using bytes = std::vector<byte>;
 
+using byte_span = span<const byte>;
+
+/**
+ * Byte buffer that keeps up to `InlineSize` bytes inside the object
+ *
+ * Hashes, keys and signatures fit inline, so they never allocate. A larger buffer
+ * moves to the heap, or to `arena` when one is given. Copies allocate from the
+ * source's arena. Iterators and pointers into the buffer are invalidated when it grows
+ * and when it is moved from while inline.
+ */
+template<size_t InlineSize = 64>
+class small_bytes {
+public:
+   using value_type     = byte;
+   using iterator       = byte*;
+   using const_iterator = const byte*;
+
+   small_bytes() = default;
+   explicit small_bytes(byte_arena* arena) : _arena(arena) {}
+   explicit small_bytes(size_t size, byte_arena* arena = nullptr) : _arena(arena) { resize(size); }
+   small_bytes(const void* data, size_t size, byte_arena* arena = nullptr) : _arena(arena) { append(data, size); }
+   small_bytes(byte_span data, byte_arena* arena = nullptr) : _arena(arena) { append(data); }
+   small_bytes(std::initializer_list<byte> data) { append(data.begin(), data.size()); }
+
+   small_bytes(const small_bytes& other) : _arena(other._arena) { append(other.data(), other.size()); }
+
+   small_bytes(small_bytes&& other) : _arena(other._arena) {
+      if (other.is_inline()) {
+         append(other.data(), other.size());
+      } else {
+         _data = std::exchange(other._data, other._inline);
+         _capacity = std::exchange(other._capacity, InlineSize);
+         _size = other._size;
+      }
+      other._size = 0;
+   }
+
+   small_bytes& operator=(const small_bytes& other) {
+      if (this != &other) {
+         clear();
+         append(other.data(), other.size());
+      }
+      return *this;
+   }
+
+   small_bytes& operator=(small_bytes&& other) {
+      if (this == &other)
+         return *this;
+      if (other.is_inline() || other._arena != _arena) {
+         clear();
+         append(other.data(), other.size());
+         other.clear();
+      } else {
+         release();
+         _data = std::exchange(other._data, other._inline);
+         _capacity = std::exchange(other._capacity, InlineSize);
+         _size = std::exchange(other._size, 0);
+      }
+      return *this;
+   }
+
+   ~small_bytes() { release(); }
+
+   byte* data() { return _data; }
+   const byte* data()const { return _data; }
+   size_t size()const { return _size; }
+   size_t capacity()const { return _capacity; }
+   bool empty()const { return _size == 0; }
+
+   /// true while the bytes are stored in the object itself
+   bool is_inline()const { return _data == _inline; }
+
+   byte* begin() { return _data; }
+   byte* end() { return _data + _size; }
+   const byte* begin()const { return _data; }
+   const byte* end()const { return _data + _size; }
+
+   byte& operator[](size_t i) { return _data[i]; }
+   const byte& operator[](size_t i)const { return _data[i]; }
+
+   operator span<byte>() { return { _data, _size }; }
+   operator byte_span()const { return { _data, _size }; }
+
+   void reserve(size_t capacity) {
+      if (capacity <= _capacity)
+         return;
+      auto _p = static_cast<byte*>(_arena ? _arena->allocate(capacity) : ::operator new(capacity));
+      std::memcpy(_p, _data, _size);
+      release();
+      _data = _p;
+      _capacity = capacity;
+   }
+
+   /// resizes to `size` bytes; new bytes are zero
+   void resize(size_t size) {
+      if (size > _size) {
+         grow(size);
+         std::memset(_data + _size, 0, size - _size);
+      }
+      _size = size;
+   }
+
+   void clear() { _size = 0; }
+
+   void push_back(byte b) {
+      grow(_size + 1);
+      _data[_size++] = b;
+   }
+
+   void append(const void* data, size_t size) {
+      if (size == 0)
+         return;
+      grow(_size + size);
+      std::memcpy(_data + _size, data, size);
+      _size += size;
+   }
+
+   void append(byte_span data) { append(data.data(), data.size()); }
+
+   friend bool operator==(const small_bytes& a, const small_bytes& b) {
+      return a._size == b._size && std::memcmp(a._data, b._data, a._size) == 0;
+   }
+   friend bool operator!=(const small_bytes& a, const small_bytes& b) { return !(a == b); }
+
+private:
+   void grow(size_t size) {
+      if (size > _capacity)
+         reserve(std::max(size, _capacity * 2));
+   }
+
+   void release() {
+      if (is_inline())
+         return;
+      if (_arena)
+         _arena->deallocate(_data, _capacity);
+      else
+         ::operator delete(_data);
+   }
+
+   byte*       _data = _inline;
+   size_t      _size = 0;
+   size_t      _capacity = InlineSize;
+   byte_arena* _arena = nullptr;
+   byte        _inline[InlineSize];
+};
+
 }
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <eosio/check.hpp>
+#include <array>
+#include <cassert>
 #include <cstring>
+#include <limits>
 #include "sha256.hpp"
 #include "../bytes.hpp"
 
@@ -41,8 +44,10 @@ protected:
       const byte* input4, size_t inlen4, byte* output, size_t outlen);
 
 private:
-   sha256 m_hash;
-   bytes m_c, m_v, m_temp;
+   using seed = std::array<byte, seed_length>;
+
+   sha256_oneshot<> m_hash;
+   seed m_c, m_v;
    uint64_t m_reseed;
 
    inline void incremental_counter_by_one(byte* inout, unsigned int size) {
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include "drbg.hpp"
+
+namespace eostd {
+
+/**
+ * Buffered random output on top of hash_drbg
+ *
+ * Output is drawn from the generator `BufferSize` bytes at a time, so the
+ * state update that ends every generate request is paid once per refill
+ * instead of once per value.
+ */
+template<size_t BufferSize = 1024>
+class drbg_stream {
+public:
+   static_assert(BufferSize > 0 && BufferSize <= hash_drbg::max_bytes_per_request, "Invalid buffer size");
+
+   explicit drbg_stream(hash_drbg& drbg)
+   : m_drbg(drbg), m_pos(BufferSize)
+   {}
+
+   // a copy would hand out the same buffered bytes as the original
+   drbg_stream(const drbg_stream&) = delete;
+   drbg_stream& operator=(const drbg_stream&) = delete;
+
+   /**
+    * Fills `output` with `size` random bytes, any size
+    */
+   void read(byte* output, size_t size) {
+      size_t count = std::min(size, BufferSize - m_pos);
+      std::memcpy(output, m_buffer + m_pos, count);
+      m_pos += count;
+      output += count;
+      size -= count;
+
+      // large reads go straight to the generator, in as few requests as allowed
+      while (size >= BufferSize) {
+         count = std::min(size, (size_t)hash_drbg::max_bytes_per_request);
+         m_drbg.generate_block(output, count);
+         output += count;
+         size -= count;
+      }
+
+      if (size) {
+         refill();
+         std::memcpy(output, m_buffer, size);
+         m_pos = size;
+      }
+   }
+
+   uint32_t next_u32() { return next<uint32_t>(); }
+   uint64_t next_u64() { return next<uint64_t>(); }
+
+   /**
+    * Returns a uniformly distributed value in [0, n), without modulo bias
+    */
+   uint64_t uniform(uint64_t n) {
+      check(n > 0, "uniform range must not be empty");
+
+      if (n <= std::numeric_limits<uint32_t>::max()) {
+         const uint32_t m = static_cast<uint32_t>(n);
+         const uint32_t threshold = static_cast<uint32_t>(-m) % m;
+         uint32_t x;
+         do {
+            x = next_u32();
+         } while (x < threshold);
+         return x % m;
+      }
+
+      const uint64_t threshold = (-n) % n;
+      uint64_t x;
+      do {
+         x = next_u64();
+      } while (x < threshold);
+      return x % n;
+   }
+
+   /**
+    * Shuffles [first, last) with Fisher-Yates
+    */
+   template<typename RandomIt>
+   void shuffle(RandomIt first, RandomIt last) {
+      using std::swap;
+      auto n = static_cast<uint64_t>(std::distance(first, last));
+      for (uint64_t i = n; i > 1; --i) {
+         swap(first[i-1], first[uniform(i)]);
+      }
+   }
+
+private:
+   hash_drbg& m_drbg;
+   byte       m_buffer[BufferSize];
+   size_t     m_pos;
+
+   void refill() {
+      m_drbg.generate_block(m_buffer, BufferSize);
+      m_pos = 0;
+   }
+
+   template<typename T>
+   T next() {
+      T value;
+      if (BufferSize - m_pos < sizeof(T)) {
+         read(reinterpret_cast<byte*>(&value), sizeof(T));
+         return value;
+      }
+      std::memcpy(&value, m_buffer + m_pos, sizeof(T));
+      m_pos += sizeof(T);
+      return value;
+   }
+};
+
+}
@@ -1,25 +1,151 @@
 #pragma once
 
-#include <memory>
+#include <eosio/check.hpp>
+#include <cstring>
+#include <type_traits>
 #include "../bytes.hpp"
+#include "sha256/sha256.h"
+
+/// When set, one-shot hashing is done by the chain's sha256 intrinsic instead of in WASM
+#ifndef EOSTD_SHA256_INTRINSIC
+#define EOSTD_SHA256_INTRINSIC 1
+#endif
 
 namespace eostd {
 
-class sha256_impl;
+/**
+ * Compressed SHA-256 state after a whole number of blocks
+ */
+struct sha256_midstate {
+   uint32_t state[SHA256_STATE_LENGTH];
+   uint64_t length; ///< bytes compressed into `state`, a multiple of sha256::block_size
+};
 
+/**
+ * SHA-256 hash with its context held by value
+ *
+ * Copying a sha256 forks the hash: the copy continues independently from
+ * the bytes fed so far, so a shared prefix only has to be hashed once.
+ */
 class sha256 {
 public:
    static constexpr unsigned int digest_size = 256 / 8; // SHA256
+   static constexpr unsigned int block_size = SHA256_BLOCK_LENGTH;
 
-   sha256();
+   sha256() { init(); }
+   explicit sha256(const sha256_midstate& m) { init(m); }
 
-   void init();
-   void update(const byte* input, size_t length);
-   void final(byte* digest);
+   void init() { SHA256Init(&context); }
+   void init(const sha256_midstate& m);
+   void update(const byte* input, size_t length) { SHA256Update(&context, input, length); }
+   void final(byte* digest) {
+      SHA256Final(&context, digest);
+      init();
+   }
    void truncated_final(byte* digest, size_t size);
 
+   /**
+    * Exports the state so that hashing can resume from it with `init(midstate)`.
+    * Only valid when the bytes fed so far fill whole blocks.
+    */
+   sha256_midstate midstate()const;
+
+private:
+   SHA256CTX context;
+};
+
+static_assert(std::is_trivially_copyable<sha256>::value, "sha256 must stay trivially copyable");
+
+/**
+ * Hashes `data` in one go
+ * @brief Hashes `data` in one go
+ *
+ * Goes through the chain's sha256 intrinsic when `EOSTD_SHA256_INTRINSIC` is set,
+ * and through the software implementation otherwise.
+ *
+ * @param data - Data you want to hash
+ * @param length - Data length
+ * @param digest - Receives the 32-byte digest
+ */
+void sha256_digest(const byte* data, size_t length, byte* digest);
+
+#if EOSTD_SHA256_INTRINSIC
+
+/**
+ * SHA-256 hash for callers that never need the midstate
+ *
+ * Updates are collected inline and hashed at once by `sha256_digest` on final().
+ * Past `InlineSize` bytes hashing continues in software, so it never allocates.
+ */
+template<size_t InlineSize = 256>
+class sha256_oneshot {
+public:
+   static constexpr unsigned int digest_size = sha256::digest_size;
+
+   void init() {
+      m_size = 0;
+      m_spilled = false;
+   }
+
+   void update(const byte* input, size_t length) {
+      if (!m_spilled) {
+         if (m_size + length <= InlineSize) {
+            std::memcpy(m_buffer + m_size, input, length);
+            m_size += length;
+            return;
+         }
+         m_hash.init();
+         m_hash.update(m_buffer, m_size);
+         m_spilled = true;
+      }
+      m_hash.update(input, length);
+   }
+
+   void final(byte* digest) {
+      if (m_spilled)
+         m_hash.final(digest);
+      else
+         sha256_digest(m_buffer, m_size, digest);
+      init();
+   }
+
+   void truncated_final(byte* digest, size_t size) {
+      eosio::check(size <= digest_size, "Invalid digest size");
+
+      byte output[digest_size];
+      final(output);
+
+      std::memcpy(digest, output, size);
+   }
+
 private:
-   std::shared_ptr<sha256_impl> my;
+   byte   m_buffer[InlineSize];
+   size_t m_size = 0;
+   bool   m_spilled = false;
+   sha256 m_hash;
 };
 
+#else
+
+template<size_t InlineSize = 256>
+using sha256_oneshot = sha256;
+
+#endif
+
+/**
+ * Hashes `count` independent messages
+ * @brief Hashes `count` independent messages
+ *
+ * Compressions of several messages are interleaved across SIMD lanes when the
+ * target supports it. Messages of similar length make the best use of the lanes.
+ *
+ * @param inputs - Message pointers
+ * @param lengths - Message lengths
+ * @param digests - Receives one digest per message
+ * @param count - Number of messages
+ */
+inline void sha256_many(const byte* const inputs[], const size_t lengths[], byte digests[][sha256::digest_size], size_t count) {
+   SHA256Many(inputs, lengths, digests, count);
+}
+
 }
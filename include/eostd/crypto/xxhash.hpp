@@ -2,9 +2,25 @@
  * @file
  */
 #pragma once
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
 
 namespace eostd {
+
+   namespace xxhash_detail {
+
+      /**
+       * Room for one of xxHash's state structs, which only src/xxhash.cpp sees, so that
+       * xxHash's headers and macros stay out of eostd's users. The sizes are checked there.
+       */
+      template<size_t Size, size_t Align>
+      struct alignas(Align) opaque_state {
+         unsigned char bytes[Size];
+      };
+
+   }
+
    /**
     * Hashes `data` using xxHash32
     * @brief Hashes `data` using xxHash32
@@ -26,4 +42,112 @@ namespace eostd {
     * @return uint64_t - Computed value
     */
    uint64_t xxh64(const char* data, uint32_t length, uint64_t seed = 0);
+
+   /**
+    * Hashes `data` using XXH3 (64-bit)
+    * @brief Hashes `data` using XXH3 (64-bit)
+    *
+    * @param data - Data you want to hash
+    * @param length - Data length
+    * @param seed - Hash seed
+    * @return uint64_t - Computed value
+    */
+   uint64_t xxh3_64(const char* data, uint32_t length, uint64_t seed = 0);
+
+   /**
+    * Hashes `data` using XXH3 (128-bit)
+    * @brief Hashes `data` using XXH3 (128-bit)
+    *
+    * @param data - Data you want to hash
+    * @param length - Data length
+    * @param seed - Hash seed
+    * @return __uint128_t - Computed value, high 64 bits first
+    */
+   __uint128_t xxh3_128(const char* data, uint32_t length, uint64_t seed = 0);
+
+   /**
+    * Incremental xxHash32: a key built from several fields can be fed one
+    * field at a time instead of being serialized into a buffer first
+    */
+   class xxh32_state {
+   public:
+      explicit xxh32_state(uint32_t seed = 0) { reset(seed); }
+
+      void reset(uint32_t seed = 0);
+      void update(const char* data, uint32_t length);
+      uint32_t digest()const;
+
+      template<typename T, typename = std::enable_if_t<std::is_trivially_copyable<T>::value>>
+      void update(const T& value) { update(reinterpret_cast<const char*>(&value), sizeof(T)); }
+
+   private:
+      xxhash_detail::opaque_state<48, 8> state;
+   };
+
+   /**
+    * Incremental xxHash64
+    */
+   class xxh64_state {
+   public:
+      explicit xxh64_state(uint64_t seed = 0) { reset(seed); }
+
+      void reset(uint64_t seed = 0);
+      void update(const char* data, uint32_t length);
+      uint64_t digest()const;
+
+      template<typename T, typename = std::enable_if_t<std::is_trivially_copyable<T>::value>>
+      void update(const T& value) { update(reinterpret_cast<const char*>(&value), sizeof(T)); }
+
+   private:
+      xxhash_detail::opaque_state<88, 8> state;
+   };
+
+   /**
+    * Incremental XXH3 (64-bit)
+    */
+   class xxh3_64_state {
+   public:
+      explicit xxh3_64_state(uint64_t seed = 0);
+
+      void reset(uint64_t seed = 0);
+      void update(const char* data, uint32_t length);
+      uint64_t digest()const;
+
+      template<typename T, typename = std::enable_if_t<std::is_trivially_copyable<T>::value>>
+      void update(const T& value) { update(reinterpret_cast<const char*>(&value), sizeof(T)); }
+
+   private:
+      xxhash_detail::opaque_state<576, 64> state;
+   };
+
+   /**
+    * Incremental XXH3 (128-bit)
+    */
+   class xxh3_128_state {
+   public:
+      explicit xxh3_128_state(uint64_t seed = 0);
+
+      void reset(uint64_t seed = 0);
+      void update(const char* data, uint32_t length);
+      __uint128_t digest()const;
+
+      template<typename T, typename = std::enable_if_t<std::is_trivially_copyable<T>::value>>
+      void update(const T& value) { update(reinterpret_cast<const char*>(&value), sizeof(T)); }
+
+   private:
+      xxhash_detail::opaque_state<576, 64> state;
+   };
+
+   /**
+    * Hasher for unordered containers that runs xxh64 over the bytes of the key
+    *
+    * Only for keys whose bytes identify their value, i.e. without padding.
+    */
+   struct xxh64_hash {
+      template<typename T>
+      size_t operator()(const T& key)const {
+         static_assert(std::has_unique_object_representations<T>::value, "key must not have padding bytes");
+         return static_cast<size_t>(xxh64(reinterpret_cast<const char*>(&key), sizeof(T)));
+      }
+   };
 }
@@ -0,0 +1,391 @@
+/**
+ * @file
+ * constexpr xxHash, bit-identical to the runtime functions in xxhash.hpp, so that
+ * hashes of literals (table tags, action names, config keys) fold at compile time
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace eostd { namespace ct {
+
+   namespace detail {
+
+      constexpr uint32_t prime32_1 = 0x9E3779B1U;
+      constexpr uint32_t prime32_2 = 0x85EBCA77U;
+      constexpr uint32_t prime32_3 = 0xC2B2AE3DU;
+      constexpr uint32_t prime32_4 = 0x27D4EB2FU;
+      constexpr uint32_t prime32_5 = 0x165667B1U;
+
+      constexpr uint64_t prime64_1 = 0x9E3779B185EBCA87ULL;
+      constexpr uint64_t prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+      constexpr uint64_t prime64_3 = 0x165667B19E3779F9ULL;
+      constexpr uint64_t prime64_4 = 0x85EBCA77C2B2AE63ULL;
+      constexpr uint64_t prime64_5 = 0x27D4EB2F165667C5ULL;
+
+      constexpr uint64_t prime_mx1 = 0x165667919E3779F9ULL;
+      constexpr uint64_t prime_mx2 = 0x9FB21C651E98DF25ULL;
+
+      constexpr size_t secret_size = 192;
+
+      constexpr uint8_t k_secret[secret_size] = {
+         0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+         0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+         0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+         0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+         0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+         0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+         0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+         0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+         0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+         0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+         0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+         0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+      };
+
+      template<typename T>
+      constexpr uint32_t read32(const T* p) {
+         return (uint32_t)(uint8_t)p[0] | (uint32_t)(uint8_t)p[1] << 8 |
+                (uint32_t)(uint8_t)p[2] << 16 | (uint32_t)(uint8_t)p[3] << 24;
+      }
+
+      template<typename T>
+      constexpr uint64_t read64(const T* p) {
+         return (uint64_t)read32(p) | (uint64_t)read32(p + 4) << 32;
+      }
+
+      constexpr uint32_t rotl32(uint32_t x, int r) { return (x << r) | (x >> (32 - r)); }
+      constexpr uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+      constexpr uint32_t swap32(uint32_t x) {
+         return (x << 24) | ((x << 8) & 0x00ff0000) | ((x >> 8) & 0x0000ff00) | (x >> 24);
+      }
+
+      constexpr uint64_t swap64(uint64_t x) {
+         return (uint64_t)swap32((uint32_t)x) << 32 | swap32((uint32_t)(x >> 32));
+      }
+
+      constexpr uint64_t mul128_fold64(uint64_t a, uint64_t b) {
+         const __uint128_t product = (__uint128_t)a * b;
+         return (uint64_t)product ^ (uint64_t)(product >> 64);
+      }
+
+      // xxHash32
+
+      constexpr uint32_t xxh32_round(uint32_t acc, uint32_t input) {
+         return rotl32(acc + input * prime32_2, 13) * prime32_1;
+      }
+
+      constexpr uint32_t xxh32_avalanche(uint32_t h) {
+         h ^= h >> 15;
+         h *= prime32_2;
+         h ^= h >> 13;
+         h *= prime32_3;
+         h ^= h >> 16;
+         return h;
+      }
+
+      // xxHash64
+
+      constexpr uint64_t xxh64_round(uint64_t acc, uint64_t input) {
+         return rotl64(acc + input * prime64_2, 31) * prime64_1;
+      }
+
+      constexpr uint64_t xxh64_merge_round(uint64_t acc, uint64_t val) {
+         return (acc ^ xxh64_round(0, val)) * prime64_1 + prime64_4;
+      }
+
+      constexpr uint64_t xxh64_avalanche(uint64_t h) {
+         h ^= h >> 33;
+         h *= prime64_2;
+         h ^= h >> 29;
+         h *= prime64_3;
+         h ^= h >> 32;
+         return h;
+      }
+
+      // XXH3 (64-bit)
+
+      constexpr uint64_t xxh3_avalanche(uint64_t h) {
+         h ^= h >> 37;
+         h *= prime_mx1;
+         h ^= h >> 32;
+         return h;
+      }
+
+      constexpr uint64_t xxh3_rrmxmx(uint64_t h, uint64_t len) {
+         h ^= rotl64(h, 49) ^ rotl64(h, 24);
+         h *= prime_mx2;
+         h ^= (h >> 35) + len;
+         h *= prime_mx2;
+         return h ^ (h >> 28);
+      }
+
+      template<typename T>
+      constexpr uint64_t xxh3_mix16(const T* input, const uint8_t* secret, uint64_t seed) {
+         return mul128_fold64(read64(input) ^ (read64(secret) + seed),
+                              read64(input + 8) ^ (read64(secret + 8) - seed));
+      }
+
+      template<typename T>
+      constexpr uint64_t xxh3_0to16(const T* input, size_t len, const uint8_t* secret, uint64_t seed) {
+         if (len > 8) {
+            const uint64_t bitflip1 = (read64(secret + 24) ^ read64(secret + 32)) + seed;
+            const uint64_t bitflip2 = (read64(secret + 40) ^ read64(secret + 48)) - seed;
+            const uint64_t lo = read64(input) ^ bitflip1;
+            const uint64_t hi = read64(input + len - 8) ^ bitflip2;
+            return xxh3_avalanche(len + swap64(lo) + hi + mul128_fold64(lo, hi));
+         }
+         if (len >= 4) {
+            seed ^= (uint64_t)swap32((uint32_t)seed) << 32;
+            const uint64_t bitflip = (read64(secret + 8) ^ read64(secret + 16)) - seed;
+            const uint64_t input64 = read32(input + len - 4) + ((uint64_t)read32(input) << 32);
+            return xxh3_rrmxmx(input64 ^ bitflip, len);
+         }
+         if (len > 0) {
+            const uint32_t combined = (uint32_t)(uint8_t)input[0] << 16 | (uint32_t)(uint8_t)input[len >> 1] << 24 |
+                                      (uint32_t)(uint8_t)input[len - 1] | (uint32_t)len << 8;
+            const uint64_t bitflip = (read32(secret) ^ read32(secret + 4)) + seed;
+            return xxh64_avalanche(combined ^ bitflip);
+         }
+         return xxh64_avalanche(seed ^ (read64(secret + 56) ^ read64(secret + 64)));
+      }
+
+      template<typename T>
+      constexpr uint64_t xxh3_17to128(const T* input, size_t len, const uint8_t* secret, uint64_t seed) {
+         uint64_t acc = len * prime64_1;
+         if (len > 32) {
+            if (len > 64) {
+               if (len > 96) {
+                  acc += xxh3_mix16(input + 48, secret + 96, seed);
+                  acc += xxh3_mix16(input + len - 64, secret + 112, seed);
+               }
+               acc += xxh3_mix16(input + 32, secret + 64, seed);
+               acc += xxh3_mix16(input + len - 48, secret + 80, seed);
+            }
+            acc += xxh3_mix16(input + 16, secret + 32, seed);
+            acc += xxh3_mix16(input + len - 32, secret + 48, seed);
+         }
+         acc += xxh3_mix16(input, secret, seed);
+         acc += xxh3_mix16(input + len - 16, secret + 16, seed);
+         return xxh3_avalanche(acc);
+      }
+
+      template<typename T>
+      constexpr uint64_t xxh3_129to240(const T* input, size_t len, const uint8_t* secret, uint64_t seed) {
+         constexpr size_t start_offset = 3;
+         constexpr size_t last_offset = 17;
+         constexpr size_t secret_size_min = 136;
+
+         uint64_t acc = len * prime64_1;
+         const size_t rounds = len / 16;
+         for (size_t i = 0; i < 8; ++i)
+            acc += xxh3_mix16(input + 16 * i, secret + 16 * i, seed);
+         acc = xxh3_avalanche(acc);
+         for (size_t i = 8; i < rounds; ++i)
+            acc += xxh3_mix16(input + 16 * i, secret + 16 * (i - 8) + start_offset, seed);
+         acc += xxh3_mix16(input + len - 16, secret + secret_size_min - last_offset, seed);
+         return xxh3_avalanche(acc);
+      }
+
+      template<typename T>
+      constexpr void xxh3_accumulate_512(uint64_t* acc, const T* input, const uint8_t* secret) {
+         for (size_t i = 0; i < 8; ++i) {
+            const uint64_t data_val = read64(input + 8 * i);
+            const uint64_t data_key = data_val ^ read64(secret + 8 * i);
+            acc[i ^ 1] += data_val;
+            acc[i] += (uint64_t)(uint32_t)data_key * (data_key >> 32);
+         }
+      }
+
+      constexpr void xxh3_scramble(uint64_t* acc, const uint8_t* secret) {
+         for (size_t i = 0; i < 8; ++i) {
+            uint64_t a = acc[i];
+            a ^= a >> 47;
+            a ^= read64(secret + 8 * i);
+            acc[i] = a * prime32_1;
+         }
+      }
+
+      template<typename T>
+      constexpr uint64_t xxh3_long(const T* input, size_t len, const uint8_t* secret) {
+         constexpr size_t stripe_len = 64;
+         constexpr size_t consume_rate = 8;
+         constexpr size_t lastacc_start = 7;
+         constexpr size_t mergeaccs_start = 11;
+         constexpr size_t stripes_per_block = (secret_size - stripe_len) / consume_rate;
+         constexpr size_t block_len = stripe_len * stripes_per_block;
+
+         uint64_t acc[8] = { prime32_3, prime64_1, prime64_2, prime64_3, prime64_4, prime32_2, prime64_5, prime32_1 };
+
+         const size_t blocks = (len - 1) / block_len;
+         for (size_t n = 0; n < blocks; ++n) {
+            for (size_t s = 0; s < stripes_per_block; ++s)
+               xxh3_accumulate_512(acc, input + n * block_len + s * stripe_len, secret + s * consume_rate);
+            xxh3_scramble(acc, secret + secret_size - stripe_len);
+         }
+
+         const size_t stripes = ((len - 1) - block_len * blocks) / stripe_len;
+         for (size_t s = 0; s < stripes; ++s)
+            xxh3_accumulate_512(acc, input + blocks * block_len + s * stripe_len, secret + s * consume_rate);
+         xxh3_accumulate_512(acc, input + len - stripe_len, secret + secret_size - stripe_len - lastacc_start);
+
+         uint64_t result = len * prime64_1;
+         for (size_t i = 0; i < 4; ++i)
+            result += mul128_fold64(acc[2 * i] ^ read64(secret + mergeaccs_start + 16 * i),
+                                    acc[2 * i + 1] ^ read64(secret + mergeaccs_start + 16 * i + 8));
+         return xxh3_avalanche(result);
+      }
+
+   }
+
+   /**
+    * Hashes `data` using xxHash32, at compile time when the input is a constant
+    * @brief Hashes `data` using xxHash32
+    *
+    * @param data - Data you want to hash
+    * @param length - Data length
+    * @param seed - Hash seed
+    * @return uint32_t - Same value as eostd::xxh32
+    */
+   constexpr uint32_t xxh32(const char* data, size_t length, uint32_t seed = 0) {
+      using namespace detail;
+
+      const char* p = data;
+      const char* const end = data + length;
+      uint32_t h = 0;
+
+      if (length >= 16) {
+         uint32_t v1 = seed + prime32_1 + prime32_2;
+         uint32_t v2 = seed + prime32_2;
+         uint32_t v3 = seed;
+         uint32_t v4 = seed - prime32_1;
+         for (; p + 16 <= end; p += 16) {
+            v1 = xxh32_round(v1, read32(p));
+            v2 = xxh32_round(v2, read32(p + 4));
+            v3 = xxh32_round(v3, read32(p + 8));
+            v4 = xxh32_round(v4, read32(p + 12));
+         }
+         h = rotl32(v1, 1) + rotl32(v2, 7) + rotl32(v3, 12) + rotl32(v4, 18);
+      } else {
+         h = seed + prime32_5;
+      }
+
+      h += static_cast<uint32_t>(length);
+
+      for (; p + 4 <= end; p += 4)
+         h = rotl32(h + read32(p) * prime32_3, 17) * prime32_4;
+      for (; p < end; ++p)
+         h = rotl32(h + (uint8_t)*p * prime32_5, 11) * prime32_1;
+
+      return xxh32_avalanche(h);
+   }
+
+   constexpr uint32_t xxh32(std::string_view s, uint32_t seed = 0) {
+      return xxh32(s.data(), s.size(), seed);
+   }
+
+   /**
+    * Hashes `data` using xxHash64, at compile time when the input is a constant
+    * @brief Hashes `data` using xxHash64
+    *
+    * @param data - Data you want to hash
+    * @param length - Data length
+    * @param seed - Hash seed
+    * @return uint64_t - Same value as eostd::xxh64
+    */
+   constexpr uint64_t xxh64(const char* data, size_t length, uint64_t seed = 0) {
+      using namespace detail;
+
+      const char* p = data;
+      const char* const end = data + length;
+      uint64_t h = 0;
+
+      if (length >= 32) {
+         uint64_t v1 = seed + prime64_1 + prime64_2;
+         uint64_t v2 = seed + prime64_2;
+         uint64_t v3 = seed;
+         uint64_t v4 = seed - prime64_1;
+         for (; p + 32 <= end; p += 32) {
+            v1 = xxh64_round(v1, read64(p));
+            v2 = xxh64_round(v2, read64(p + 8));
+            v3 = xxh64_round(v3, read64(p + 16));
+            v4 = xxh64_round(v4, read64(p + 24));
+         }
+         h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+         h = xxh64_merge_round(h, v1);
+         h = xxh64_merge_round(h, v2);
+         h = xxh64_merge_round(h, v3);
+         h = xxh64_merge_round(h, v4);
+      } else {
+         h = seed + prime64_5;
+      }
+
+      h += static_cast<uint64_t>(length);
+
+      for (; p + 8 <= end; p += 8)
+         h = rotl64(h ^ xxh64_round(0, read64(p)), 27) * prime64_1 + prime64_4;
+      if (p + 4 <= end) {
+         h = rotl64(h ^ (uint64_t)read32(p) * prime64_1, 23) * prime64_2 + prime64_3;
+         p += 4;
+      }
+      for (; p < end; ++p)
+         h = rotl64(h ^ (uint8_t)*p * prime64_5, 11) * prime64_1;
+
+      return xxh64_avalanche(h);
+   }
+
+   constexpr uint64_t xxh64(std::string_view s, uint64_t seed = 0) {
+      return xxh64(s.data(), s.size(), seed);
+   }
+
+   /**
+    * Hashes `data` using XXH3 (64-bit), at compile time when the input is a constant
+    * @brief Hashes `data` using XXH3 (64-bit)
+    *
+    * @param data - Data you want to hash
+    * @param length - Data length
+    * @param seed - Hash seed
+    * @return uint64_t - Same value as eostd::xxh3_64
+    */
+   constexpr uint64_t xxh3_64(const char* data, size_t length, uint64_t seed = 0) {
+      using namespace detail;
+
+      if (length <= 16)
+         return xxh3_0to16(data, length, k_secret, seed);
+      if (length <= 128)
+         return xxh3_17to128(data, length, k_secret, seed);
+      if (length <= 240)
+         return xxh3_129to240(data, length, k_secret, seed);
+      if (seed == 0)
+         return xxh3_long(data, length, k_secret);
+
+      // seeded long inputs hash against a secret derived from the seed
+      uint8_t secret[secret_size] = {};
+      for (size_t i = 0; i < secret_size / 16; ++i) {
+         const uint64_t lo = read64(k_secret + 16 * i) + seed;
+         const uint64_t hi = read64(k_secret + 16 * i + 8) - seed;
+         for (size_t b = 0; b < 8; ++b) {
+            secret[16 * i + b] = static_cast<uint8_t>(lo >> (8 * b));
+            secret[16 * i + 8 + b] = static_cast<uint8_t>(hi >> (8 * b));
+         }
+      }
+      return xxh3_long(data, length, secret);
+   }
+
+   constexpr uint64_t xxh3_64(std::string_view s, uint64_t seed = 0) {
+      return xxh3_64(s.data(), s.size(), seed);
+   }
+
+} /// namespace ct
+
+namespace literals {
+
+   constexpr uint32_t operator""_xxh32(const char* s, size_t n) { return ct::xxh32(s, n); }
+   constexpr uint64_t operator""_xxh64(const char* s, size_t n) { return ct::xxh64(s, n); }
+   constexpr uint64_t operator""_xxh3(const char* s, size_t n) { return ct::xxh3_64(s, n); }
+
+} /// namespace literals
+
+} /// namespace eostd
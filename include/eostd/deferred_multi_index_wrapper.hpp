@@ -0,0 +1,140 @@
+#pragma once
+
+#include "multi_index_wrapper.hpp"
+
+namespace eostd {
+
+   /**
+    * multi_index_wrapper that holds writes to its current row back until commit
+    *
+    * `emplace` and `modify` work on a copy of the row in memory, and the copy is written
+    * once, on `commit()`, when the wrapper moves to another row, or when it goes out of
+    * scope. Repeated writes to the same row are coalesced:
+    *
+    * - modify, modify, ... is one update
+    * - emplace followed by modifies is one store
+    * - modify followed by erase is one remove, and emplace followed by erase is nothing
+    *
+    * Reads through `operator->` see the pending copy. `erase()` is never deferred, so it
+    * moves to the next row right away, as in multi_index_wrapper. When it drops a row
+    * that was emplaced in the same batch, the wrapper stays on the row it was on before.
+    * Rows must be default constructible and copyable.
+    *
+    * Other wrappers on the same (code, scope) make the write held back before they open or
+    * read the table, see held_writes, so a helper called in between sees the row as this
+    * wrapper left it, at the cost of the write being made then.
+    */
+   template <typename T, eosio::name::raw IndexName = name(), typename Extractor = uint64_t>
+   class deferred_multi_index_wrapper : public multi_index_wrapper<T, IndexName, Extractor> {
+   protected:
+      using base     = multi_index_wrapper<T, IndexName, Extractor>;
+      using row_type = std::decay_t<decltype(*std::declval<typename T::const_iterator>())>;
+
+      enum class pending : uint8_t { none, emplace, modify };
+
+      row_type _row;
+      name     _payer;
+      pending  _pending = pending::none;
+
+      held_write _held{ base::code(), base::_tbl.get_scope(), this, &commit_held, nullptr };
+
+      static void commit_held(void* wrapper) { static_cast<deferred_multi_index_wrapper*>(wrapper)->commit(); }
+
+      /// holds `op` back, where other wrappers on the table can make it
+      void hold(pending op) {
+         if (_pending == pending::none)
+            held_writes<T>::hold(_held);
+         _pending = op;
+      }
+
+      /// stops holding the write back and returns what it was
+      pending release() {
+         const auto _op = _pending;
+         if (_op != pending::none)
+            held_writes<T>::release(_held);
+         _pending = pending::none;
+         return _op;
+      }
+
+   public:
+      using base::base;
+
+      deferred_multi_index_wrapper(const deferred_multi_index_wrapper&) = delete;
+      deferred_multi_index_wrapper& operator=(const deferred_multi_index_wrapper&) = delete;
+
+      ~deferred_multi_index_wrapper() { commit(); }
+
+      bool exists()const { return _pending != pending::none || base::exists(); }
+      operator bool()const { return exists(); }
+
+      const row_type* operator->()const {
+         return _pending != pending::none ? &_row : base::operator->().operator->();
+      }
+
+      /// true while a write is held back
+      bool dirty()const { return _pending != pending::none; }
+
+      /// writes the pending row, if any
+      void commit() {
+         const auto _op = release();
+         if (_op == pending::emplace)
+            base::emplace(_payer, [&](auto& r) { r = _row; });
+         else if (_op == pending::modify)
+            base::modify(_payer, [&](auto& r) { r = _row; });
+      }
+
+      template<typename Lambda>
+      void emplace(name payer, Lambda&& updater) {
+         commit();
+         _row = row_type{};
+         updater(_row);
+         _payer = payer;
+         hold(pending::emplace);
+      }
+
+      template<typename Lambda>
+      void modify(name payer, Lambda&& updater) {
+         if (_pending == pending::none) {
+            eosio::check(base::exists(), "cannot pass end iterator to modify");
+            _row = *base::operator->();
+            hold(pending::modify);
+         }
+         const auto _pk = _row.primary_key();
+         updater(_row);
+         eosio::check(_pk == _row.primary_key(), "updater cannot change primary key when modifying an object");
+         _payer = payer;
+      }
+
+      void erase() {
+         if (release() != pending::emplace)
+            base::erase();
+      }
+
+      deferred_multi_index_wrapper& operator++() { commit(); base::operator++(); return (*this); }
+      deferred_multi_index_wrapper& operator--() { commit(); base::operator--(); return (*this); }
+      auto operator++(int) { commit(); return base::operator++(0); }
+      auto operator--(int) { commit(); return base::operator--(0); }
+
+      template<typename Key>
+      deferred_multi_index_wrapper& lower_bound(const Key& key) { commit(); base::lower_bound(key); return (*this); }
+      template<typename Key>
+      deferred_multi_index_wrapper& upper_bound(const Key& key) { commit(); base::upper_bound(key); return (*this); }
+
+      /// ranges read the table, so pending writes are committed first
+      template<typename... Keys>
+      auto range(const Keys&... keys)& { commit(); return base::range(keys...); }
+      template<typename... Keys>
+      auto range(const Keys&... keys)&& = delete;
+
+      /// bulk erases see the table with the pending write in it
+      template<typename Key>
+      uint64_t erase_range(const Key& lo, const Key& hi, uint64_t max_rows = std::numeric_limits<uint64_t>::max()) {
+         commit();
+         return base::erase_range(lo, hi, max_rows);
+      }
+      template<typename Pred>
+      uint64_t erase_if(Pred&& pred, uint64_t max_rows) { commit(); return base::erase_if(std::forward<Pred>(pred), max_rows); }
+      uint64_t clear_scope(uint64_t max_rows) { commit(); return base::clear_scope(max_rows); }
+   };
+
+}
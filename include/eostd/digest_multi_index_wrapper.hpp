@@ -0,0 +1,232 @@
+#pragma once
+
+#include "multi_index_wrapper.hpp"
+#include "bytes.hpp"
+#include "crypto/sha256.hpp"
+#include "crypto/xxhash.hpp"
+
+#include <array>
+#include <cstring>
+
+namespace eostd {
+
+   /// row hash for table_digest: xxh64 of the serialized row, in one lane
+   struct xxh64_row_hash {
+      static constexpr size_t lanes = 1;
+
+      static void hash(const byte* data, size_t size, uint64_t* lanes_out) {
+         lanes_out[0] = xxh64(reinterpret_cast<const char*>(data), static_cast<uint32_t>(size));
+      }
+   };
+
+   /// row hash for table_digest: SHA-256 of the serialized row, as four little-endian lanes
+   struct sha256_row_hash {
+      static constexpr size_t lanes = 4;
+
+      static void hash(const byte* data, size_t size, uint64_t* lanes_out) {
+         byte _digest[sha256::digest_size];
+         sha256_digest(data, size, _digest);
+         std::memcpy(lanes_out, _digest, sizeof(_digest));
+      }
+   };
+
+   /**
+    * Order-independent digest of a table's rows
+    *
+    * Each lane is the sum, modulo 2^64, of that lane of every row's hash, so rows can be
+    * added and removed in any order and equal contents always give equal digests.
+    */
+   template <size_t Lanes>
+   struct table_digest {
+      std::array<uint64_t, Lanes> sum = {};
+      uint64_t                    rows = 0;
+
+      void add(const uint64_t* hash) {
+         for (size_t i = 0; i < Lanes; ++i)
+            sum[i] += hash[i];
+         ++rows;
+      }
+
+      void remove(const uint64_t* hash) {
+         for (size_t i = 0; i < Lanes; ++i)
+            sum[i] -= hash[i];
+         --rows;
+      }
+
+      friend bool operator==(const table_digest& a, const table_digest& b) { return a.sum == b.sum && a.rows == b.rows; }
+      friend bool operator!=(const table_digest& a, const table_digest& b) { return !(a == b); }
+
+      EOSLIB_SERIALIZE(table_digest, (sum)(rows))
+   };
+
+   namespace digest_detail {
+
+      /// laid out like eosio::singleton's row, so other contracts can read it with a singleton
+      template <eosio::name::raw DigestName, typename Digest>
+      struct digest_row {
+         Digest value;
+
+         uint64_t primary_key()const { return static_cast<uint64_t>(DigestName); }
+
+         EOSLIB_SERIALIZE(digest_row, (value))
+      };
+
+   }
+
+   /**
+    * multi_index_wrapper that keeps a digest of its table's rows up to date
+    *
+    * `emplace`, `modify`, `erase` and the bulk erases hash the rows they touch, serialized
+    * as stored, and fold them into a `table_digest` kept in the same scope as a singleton
+    * named `DigestName`. Each write costs a hash of the row and one update of the digest
+    * row; a bulk erase updates it once. Reading the digest costs no scan:
+    *
+    * - in the contract, `digest()`
+    * - from any contract, `eosio::singleton<DigestName, table_digest<Hash::lanes>>(code, scope).get()`
+    *
+    * `DigestName` must not name a table of its own. Every write to the table has to go
+    * through this wrapper, or the digest goes stale; the contract pays for the digest row.
+    * Tables written before opting in, or with a different `Hash`, need one
+    * `recompute_digest()`.
+    */
+   template <typename T, eosio::name::raw DigestName, typename Hash = xxh64_row_hash,
+             eosio::name::raw IndexName = name(), typename Extractor = uint64_t>
+   class digest_multi_index_wrapper : public multi_index_wrapper<T, IndexName, Extractor> {
+   protected:
+      using base        = multi_index_wrapper<T, IndexName, Extractor>;
+      using row_type    = std::decay_t<decltype(*std::declval<typename T::const_iterator>())>;
+      using digest_type = table_digest<Hash::lanes>;
+      using digest_row  = digest_detail::digest_row<DigestName, digest_type>;
+      using digests     = eosio::multi_index<DigestName, digest_row>;
+
+      /// always shared, so every wrapper of the scope folds its writes into the same digest
+      digests& _digests;
+
+      /// hashes `row` as it is serialized in the table
+      static void hash(const row_type& row, uint64_t* lanes) {
+         small_bytes<256> _packed;
+         _packed.resize(eosio::pack_size(row));
+         eosio::datastream<char*> _ds(reinterpret_cast<char*>(_packed.data()), _packed.size());
+         _ds << row;
+         Hash::hash(_packed.data(), _packed.size(), lanes);
+      }
+
+      static void add(digest_type& digest, const row_type& row) {
+         uint64_t _hash[Hash::lanes];
+         hash(row, _hash);
+         digest.add(_hash);
+      }
+
+      static void remove(digest_type& digest, const row_type& row) {
+         uint64_t _hash[Hash::lanes];
+         hash(row, _hash);
+         digest.remove(_hash);
+      }
+
+      void store(const digest_type& digest) {
+         auto _itr = _digests.find(static_cast<uint64_t>(DigestName));
+         if (_itr != _digests.end())
+            _digests.modify(_itr, base::code(), [&](auto& r) { r.value = digest; });
+         else
+            _digests.emplace(base::code(), [&](auto& r) { r.value = digest; });
+      }
+
+      /// erases rows through `erase`, a bulk erase of the base taking a predicate, and folds them out
+      template<typename Pred, typename Erase>
+      uint64_t erase_counted(Pred&& pred, Erase&& erase) {
+         auto _digest = digest();
+         const uint64_t _erased = erase([&](const row_type& r) {
+            if (!pred(r))
+               return false;
+            remove(_digest, r);
+            return true;
+         });
+         if (_erased)
+            store(_digest);
+         return _erased;
+      }
+
+   public:
+      template<typename... Args>
+      digest_multi_index_wrapper(name code, name scope, Args&&... args)
+      : base(code, scope, std::forward<Args>(args)...)
+      , _digests(table_cache<digests>::get(code, scope.value))
+      {}
+
+      template<typename... Args>
+      digest_multi_index_wrapper(shared_table_t, name code, name scope, Args&&... args)
+      : base(shared_table, code, scope, std::forward<Args>(args)...)
+      , _digests(table_cache<digests>::get(code, scope.value))
+      {}
+
+      /// digest of the table as of the last write, or of an empty table if it was never written
+      digest_type digest()const {
+         auto _itr = _digests.find(static_cast<uint64_t>(DigestName));
+         return _itr != _digests.end() ? _itr->value : digest_type{};
+      }
+
+      /**
+       * Hashes every row of the scope and stores the result as its digest
+       * @brief Hashes every row of the scope and stores the result as its digest
+       *
+       * For tables that were written before they opted in. This scans the whole table,
+       * so it only fits in one action for tables of moderate size.
+       *
+       * @return digest_type - The new digest
+       */
+      digest_type recompute_digest() {
+         digest_type _digest;
+         for (const auto& r : base::_tbl)
+            add(_digest, r);
+         store(_digest);
+         return _digest;
+      }
+
+      template<typename Lambda>
+      void emplace(name payer, Lambda&& updater) {
+         base::emplace(payer, std::forward<Lambda&&>(updater));
+         auto _digest = digest();
+         add(_digest, *base::operator->());
+         store(_digest);
+      }
+
+      template<typename Lambda>
+      void modify(name payer, Lambda&& updater) {
+         eosio::check(base::exists(), "cannot pass end iterator to modify");
+         auto _digest = digest();
+         remove(_digest, *base::operator->());
+         base::modify(payer, std::forward<Lambda&&>(updater));
+         add(_digest, *base::operator->());
+         store(_digest);
+      }
+
+      void erase() {
+         eosio::check(base::exists(), "cannot pass end iterator to erase");
+         auto _digest = digest();
+         remove(_digest, *base::operator->());
+         base::erase();
+         store(_digest);
+      }
+
+      template<typename Key>
+      uint64_t erase_range(const Key& lo, const Key& hi, uint64_t max_rows = std::numeric_limits<uint64_t>::max()) {
+         return erase_counted(multi_index_detail::any_row(), [this, &lo, &hi, max_rows](auto&& pred) {
+            return base::erase_range_if(lo, hi, pred, max_rows);
+         });
+      }
+
+      template<typename Pred>
+      uint64_t erase_if(Pred&& pred, uint64_t max_rows) {
+         return erase_counted(std::forward<Pred>(pred), [this, max_rows](auto&& pred) {
+            return base::erase_if(pred, max_rows);
+         });
+      }
+
+      uint64_t clear_scope(uint64_t max_rows) {
+         return erase_counted(multi_index_detail::any_row(), [this, max_rows](auto&& pred) {
+            return base::clear_scope_if(pred, max_rows);
+         });
+      }
+   };
+
+}
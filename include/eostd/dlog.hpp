@@ -1,14 +1,4 @@
 #pragma once
 
-#include <eosio/print.hpp>
-
-namespace eostd {
-
-template<typename... Args>
-inline void dlog(Args&&... args) {
-#ifndef NDEBUG
-   eosio::print(std::forward<Args>(args)...);
-#endif
-}
-
-} /// namespace eostd
+/// dlog is the debug level of the leveled logs in log.hpp
+#include "log.hpp"
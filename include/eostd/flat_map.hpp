@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace eostd {
+
+   /**
+    * Open-addressing hash map for small, hot lookup tables
+    *
+    * Entries sit in one flat array and are probed linearly from the key's hash. A
+    * parallel byte array tags every used slot with 7 bits of the hash, so most
+    * mismatching slots are skipped without comparing keys. Erase shifts the entries
+    * that follow back into the hole, so there are no tombstones to slow probing down.
+    *
+    * Keys and values must be default constructible. Any insertion that grows the map,
+    * and any erase, invalidates iterators and references.
+    */
+   template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+   class flat_map {
+   public:
+      using key_type    = K;
+      using mapped_type = V;
+      using value_type  = std::pair<K, V>;
+
+      template <bool IsConst>
+      class basic_iterator {
+      public:
+         using map_type          = std::conditional_t<IsConst, const flat_map, flat_map>;
+         using value_type        = flat_map::value_type;
+         using reference         = std::conditional_t<IsConst, const value_type&, value_type&>;
+         using pointer           = std::conditional_t<IsConst, const value_type*, value_type*>;
+         using difference_type   = std::ptrdiff_t;
+         using iterator_category = std::forward_iterator_tag;
+
+         basic_iterator(map_type* map, size_t pos) : _map(map), _pos(pos) { skip(); }
+         operator basic_iterator<true>()const { return basic_iterator<true>(_map, _pos); }
+
+         reference operator*()const { return _map->_slots[_pos]; }
+         pointer operator->()const { return &_map->_slots[_pos]; }
+
+         basic_iterator& operator++() { ++_pos; skip(); return (*this); }
+         basic_iterator operator++(int) { basic_iterator _prev = *this; ++(*this); return _prev; }
+
+         friend bool operator==(const basic_iterator& a, const basic_iterator& b) { return a._pos == b._pos; }
+         friend bool operator!=(const basic_iterator& a, const basic_iterator& b) { return a._pos != b._pos; }
+
+      private:
+         void skip() {
+            while (_pos < _map->_tags.size() && _map->_tags[_pos] == empty_tag)
+               ++_pos;
+         }
+
+         map_type* _map;
+         size_t    _pos;
+      };
+
+      using iterator       = basic_iterator<false>;
+      using const_iterator = basic_iterator<true>;
+
+      flat_map() = default;
+      explicit flat_map(size_t capacity) { reserve(capacity); }
+
+      size_t size()const { return _size; }
+      bool empty()const { return _size == 0; }
+
+      iterator begin() { return iterator(this, 0); }
+      iterator end() { return iterator(this, _tags.size()); }
+      const_iterator begin()const { return const_iterator(this, 0); }
+      const_iterator end()const { return const_iterator(this, _tags.size()); }
+
+      void clear() {
+         _slots.clear();
+         _tags.clear();
+         _size = 0;
+      }
+
+      /// makes room for `count` entries without growing again
+      void reserve(size_t count) {
+         size_t _capacity = 8;
+         while (_capacity * 3 < count * 4)
+            _capacity <<= 1;
+         if (_capacity > _tags.size())
+            rehash(_capacity);
+      }
+
+      iterator find(const K& key) {
+         if (_size == 0)
+            return end();
+         const size_t _pos = slot(key, _hash(key));
+         return _tags[_pos] == empty_tag ? end() : iterator(this, _pos);
+      }
+      const_iterator find(const K& key)const { return const_cast<flat_map*>(this)->find(key); }
+
+      bool contains(const K& key)const { return find(key) != end(); }
+      size_t count(const K& key)const { return contains(key) ? 1 : 0; }
+
+      /**
+       * Inserts `key` with a value built from `args`, unless the key is already there
+       * @brief Inserts `key` with a value built from `args`
+       *
+       * @param key - Key to insert
+       * @param args - Arguments for the value's constructor
+       * @return std::pair<iterator, bool> - The entry for `key`, and whether it was inserted
+       */
+      template <typename... Args>
+      std::pair<iterator, bool> emplace(const K& key, Args&&... args) {
+         const size_t _h = _hash(key);
+         size_t _pos = 0;
+         if (!_tags.empty()) {
+            _pos = slot(key, _h);
+            if (_tags[_pos] != empty_tag)
+               return { iterator(this, _pos), false };
+         }
+
+         // only a key that is not there yet grows the map
+         if ((_size + 1) * 4 > _tags.size() * 3) {
+            rehash(_tags.empty() ? 8 : _tags.size() * 2);
+            _pos = slot(key, _h);
+         }
+
+         _slots[_pos] = value_type(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+         _tags[_pos] = tag(_h);
+         ++_size;
+         return { iterator(this, _pos), true };
+      }
+
+      std::pair<iterator, bool> insert(const value_type& value) { return emplace(value.first, value.second); }
+
+      V& operator[](const K& key) { return emplace(key).first->second; }
+
+      /// erases `key`, returning how many entries were erased
+      size_t erase(const K& key) {
+         if (_size == 0)
+            return 0;
+         size_t _hole = slot(key, _hash(key));
+         if (_tags[_hole] == empty_tag)
+            return 0;
+
+         const size_t _mask = _tags.size() - 1;
+         for (size_t _pos = (_hole + 1) & _mask; _tags[_pos] != empty_tag; _pos = (_pos + 1) & _mask) {
+            // an entry may fill the hole unless its home slot lies between the hole and itself
+            const size_t _home = _hash(_slots[_pos].first) & _mask;
+            if (((_pos - _home) & _mask) >= ((_pos - _hole) & _mask)) {
+               _slots[_hole] = std::move(_slots[_pos]);
+               _tags[_hole] = _tags[_pos];
+               _hole = _pos;
+            }
+         }
+         _slots[_hole] = value_type();
+         _tags[_hole] = empty_tag;
+         --_size;
+         return 1;
+      }
+
+   private:
+      static constexpr uint8_t empty_tag = 0;
+
+      static uint8_t tag(size_t h) { return static_cast<uint8_t>(h >> (sizeof(size_t) * 8 - 7)) | 0x80; }
+
+      /// the slot holding `key`, or the empty slot where it belongs
+      size_t slot(const K& key, size_t h)const {
+         const size_t _mask = _tags.size() - 1;
+         const uint8_t _tag = tag(h);
+         for (size_t _pos = h & _mask;; _pos = (_pos + 1) & _mask) {
+            if (_tags[_pos] == empty_tag || (_tags[_pos] == _tag && _eq(_slots[_pos].first, key)))
+               return _pos;
+         }
+      }
+
+      void rehash(size_t capacity) {
+         auto _old_slots = std::exchange(_slots, std::vector<value_type>(capacity));
+         auto _old_tags = std::exchange(_tags, std::vector<uint8_t>(capacity, empty_tag));
+
+         for (size_t i = 0; i < _old_tags.size(); ++i) {
+            if (_old_tags[i] == empty_tag)
+               continue;
+            const size_t _pos = slot(_old_slots[i].first, _hash(_old_slots[i].first));
+            _slots[_pos] = std::move(_old_slots[i]);
+            _tags[_pos] = _old_tags[i];
+         }
+      }
+
+      std::vector<value_type> _slots;
+      std::vector<uint8_t>    _tags;
+      size_t                  _size = 0;
+      Hash                    _hash;
+      KeyEqual                _eq;
+   };
+
+}
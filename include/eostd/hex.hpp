@@ -1,49 +1,309 @@
 #pragma once
 
+/**
+ * @file
+ * Hex encoding and decoding.
+ *
+ * Everything is inline by default. Building eostd with EOSTD_HEX_COMPILED moves the
+ * buffer codecs out of line into src/hex.cpp, which keeps contract code smaller
+ * when hex is used from many places.
+ */
+
 #include <eosio/check.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
+#include "bytes.hpp"
+
+#ifdef EOSTD_HEX_COMPILED
+#define EOSTD_HEX_INLINE
+#ifdef EOSTD_HEX_IMPL
+#define EOSTD_HEX_DEFINE 1
+#else
+#define EOSTD_HEX_DEFINE 0
+#endif
+#else
+#define EOSTD_HEX_INLINE inline
+#define EOSTD_HEX_DEFINE 1
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define EOSTD_HEX_SWAR 1
+#else
+#define EOSTD_HEX_SWAR 0
+#endif
 
 namespace eostd {
 
-uint8_t from_hex(char c) {
-   if (c >= '0' && c <= '9')
-      return c - '0';
-   if (c >= 'a' && c <= 'f')
-      return c - 'a' + 10;
-   if (c >= 'A' && c <= 'F')
-      return c - 'A' + 10;
-   eosio::check(false, "invalid hex character `" + std::string(1, c) + "`");
-   return 0;
-}
-
-std::string to_hex(const char* d, uint32_t s) {
-   std::string r;
-   const char* to_hex = "0123456789abcdef";
-   auto c = reinterpret_cast<const uint8_t*>(d);
-   for (auto i = 0; i < s; ++i)
-      (r += to_hex[(c[i]>>4)]) += to_hex[(c[i]&0x0f)];
+namespace hex_detail {
+
+   constexpr uint8_t invalid = 0xff;
+
+   constexpr std::array<uint8_t, 256> make_decode_table() {
+      std::array<uint8_t, 256> t{};
+      for (int c = 0; c < 256; ++c) {
+         if (c >= '0' && c <= '9')
+            t[c] = c - '0';
+         else if (c >= 'a' && c <= 'f')
+            t[c] = c - 'a' + 10;
+         else if (c >= 'A' && c <= 'F')
+            t[c] = c - 'A' + 10;
+         else
+            t[c] = invalid;
+      }
+      return t;
+   }
+
+   /// nibble value of every char, `invalid` for non-hex chars
+   inline constexpr std::array<uint8_t, 256> decode_table = make_decode_table();
+
+   inline constexpr char digits[] = "0123456789abcdef";
+
+   // deliberately not constexpr: reaching it during constant evaluation is a compile error
+   inline void invalid_hex_literal() {
+      eosio::check(false, "invalid hex literal");
+   }
+
+   constexpr uint8_t literal_nibble(char c) {
+      const uint8_t v = decode_table[static_cast<uint8_t>(c)];
+      if (v == invalid)
+         invalid_hex_literal();
+      return v;
+   }
+
+   template<size_t Size>
+   constexpr std::array<byte, Size> decode_literal(const char* s, size_t len) {
+      std::array<byte, Size> r{};
+      size_t i = 0, n = 0;
+      if (len & 1)
+         r[n++] = literal_nibble(s[i++]);
+      for (; i < len; i += 2)
+         r[n++] = static_cast<byte>(literal_nibble(s[i]) << 4 | literal_nibble(s[i + 1]));
+      return r;
+   }
+
+   constexpr uint64_t ones = 0x0101010101010101ULL;
+   constexpr uint64_t high = ones * 0x80;
+
+   /// four bytes, first byte lowest, to eight lowercase hex chars, first char lowest
+   inline uint64_t encode4(uint32_t x) {
+      uint64_t w = x;
+      w = (w | (w << 16)) & 0x0000FFFF0000FFFFULL;
+      w = (w | (w << 8))  & 0x00FF00FF00FF00FFULL;
+
+      const uint64_t n = ((w >> 4) & 0x000F000F000F000FULL) | ((w & 0x000F000F000F000FULL) << 8);
+      return n + ones * '0' + (((n + ones * 6) >> 4) & ones) * ('a' - '0' - 10);
+   }
+
+   /// eight hex chars, first char lowest, to four bytes; false when any char is not hex
+   inline bool decode8(uint64_t v, uint32_t& out) {
+      if (v & high)
+         return false;
+
+      const uint64_t digit = ((v | high) - ones * '0') & ~((v | high) - ones * ('9' + 1)) & high;
+      const uint64_t lower = v | ones * 0x20;
+      const uint64_t alpha = ((lower | high) - ones * 'a') & ~((lower | high) - ones * ('f' + 1)) & high;
+      if ((digit | alpha) != high)
+         return false;
+
+      const uint64_t n = (v & ones * 0x0f) + ((v >> 6) & ones) * 9;
+      uint64_t p = ((n << 4) | (n >> 8)) & 0x00FF00FF00FF00FFULL;
+      p = (p | (p >> 8))  & 0x0000FFFF0000FFFFULL;
+      p = (p | (p >> 16)) & 0x00000000FFFFFFFFULL;
+      out = static_cast<uint32_t>(p);
+      return true;
+   }
+
+}
+
+/// returned by try_from_hex when the input holds a non-hex char
+constexpr size_t hex_npos = static_cast<size_t>(-1);
+
+/**
+ * Writes the lowercase hex form of `size` bytes at `data` to `out`
+ * @brief Writes the lowercase hex form of `size` bytes at `data` to `out`
+ *
+ * @param data - Bytes to encode
+ * @param size - Number of bytes
+ * @param out - Receives 2 * size chars, not null-terminated
+ */
+EOSTD_HEX_INLINE void to_hex(const void* data, size_t size, char* out);
+
+/**
+ * Hex form of a fixed-size byte array, e.g. a checksum, without touching the heap
+ */
+template<typename T, size_t N, typename = std::enable_if_t<sizeof(T) == 1>>
+inline std::array<char, 2 * N> to_hex(const std::array<T, N>& data) {
+   std::array<char, 2 * N> r;
+   to_hex(data.data(), N, r.data());
+   return r;
+}
+
+EOSTD_HEX_INLINE std::string to_hex(const char* d, uint32_t s);
+EOSTD_HEX_INLINE std::string to_hex(const std::vector<char>& data);
+EOSTD_HEX_INLINE uint8_t from_hex(char c);
+
+/**
+ * Decodes hex `s` into `out`, without aborting
+ * @brief Decodes hex `s` into `out`, without aborting
+ *
+ * A leading "0x" is skipped. An odd number of digits is read as if a '0' led them.
+ * Decoding stops once `outlen` bytes are written.
+ *
+ * @param s - Hex digits, upper or lower case
+ * @param out - Receives the decoded bytes
+ * @param outlen - Capacity of `out`
+ * @return size_t - Bytes written, or hex_npos if a consumed char is not a hex digit
+ */
+EOSTD_HEX_INLINE size_t try_from_hex(std::string_view s, void* out, size_t outlen);
+
+/**
+ * Decodes hex `s` into `out`, aborting on a non-hex char
+ * @brief Decodes hex `s` into `out`
+ *
+ * @param s - Hex digits, optionally prefixed with "0x"
+ * @param out - Receives the decoded bytes
+ * @param outlen - Capacity of `out`
+ * @return size_t - Bytes written
+ */
+EOSTD_HEX_INLINE size_t from_hex(std::string_view s, char* out, size_t outlen);
+
+/**
+ * Decodes a hex string literal at compile time
+ * @brief Decodes a hex string literal at compile time
+ *
+ * `constexpr auto key = hex_literal("00ff...");` costs nothing at runtime, and a
+ * non-hex char in the literal fails to compile. There is no "0x" prefix; an odd
+ * number of digits is read as if a '0' led them.
+ *
+ * @param s - Hex string literal
+ * @return std::array<byte, N> - Decoded bytes
+ */
+template<size_t N>
+constexpr std::array<byte, N / 2> hex_literal(const char (&s)[N]) {
+   return hex_detail::decode_literal<N / 2>(s, N - 1);
+}
+
+namespace literals {
+
+#if defined(__clang__) || defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wgnu-string-literal-operator-template"
+#endif
+   /**
+    * `"00ff..."_hex` is `hex_literal("00ff...")`
+    */
+   template<typename CharT, CharT... Cs>
+   constexpr std::array<byte, (sizeof...(Cs) + 1) / 2> operator""_hex() {
+      constexpr char s[] = { static_cast<char>(Cs)..., '\0' };
+      return hex_detail::decode_literal<(sizeof...(Cs) + 1) / 2>(s, sizeof...(Cs));
+   }
+#pragma GCC diagnostic pop
+#endif
+
+} /// namespace literals
+
+#if EOSTD_HEX_DEFINE
+
+EOSTD_HEX_INLINE void to_hex(const void* data, size_t size, char* out) {
+   auto c = static_cast<const uint8_t*>(data);
+   size_t i = 0;
+#if EOSTD_HEX_SWAR
+   for (; i + 8 <= size; i += 8) {
+      uint32_t lo, hi;
+      std::memcpy(&lo, c + i, 4);
+      std::memcpy(&hi, c + i + 4, 4);
+      const uint64_t a = hex_detail::encode4(lo), b = hex_detail::encode4(hi);
+      std::memcpy(out + 2 * i, &a, 8);
+      std::memcpy(out + 2 * i + 8, &b, 8);
+   }
+#endif
+   for (; i < size; ++i) {
+      out[2 * i]     = hex_detail::digits[c[i] >> 4];
+      out[2 * i + 1] = hex_detail::digits[c[i] & 0x0f];
+   }
+}
+
+EOSTD_HEX_INLINE std::string to_hex(const char* d, uint32_t s) {
+   std::string r(2 * static_cast<size_t>(s), '\0');
+   to_hex(d, s, &r[0]);
    return r;
 }
 
-size_t from_hex(const std::string& s, char* out, size_t outlen) {
-   bool require_pad = s.size() % 2;
-   auto out_pos = reinterpret_cast<uint8_t*>(out);
-   auto out_end = out_pos + outlen;
-   auto c = s.begin() + (s.find("0x") != std::string::npos) * 2;
-   for (; c != s.end() && out_pos != out_end; ++c) {
-      if (!require_pad) 
-         *out_pos = from_hex(*c++) << 4;
-      *out_pos |= from_hex(*c);
-      ++out_pos;
-      require_pad = false;
+EOSTD_HEX_INLINE std::string to_hex(const std::vector<char>& data) {
+   return to_hex(data.data(), static_cast<uint32_t>(data.size()));
+}
+
+EOSTD_HEX_INLINE uint8_t from_hex(char c) {
+   const uint8_t v = hex_detail::decode_table[static_cast<uint8_t>(c)];
+   if (v == hex_detail::invalid)
+      eosio::check(false, "invalid hex character `" + std::string(1, c) + "`");
+   return v;
+}
+
+EOSTD_HEX_INLINE size_t try_from_hex(std::string_view s, void* out, size_t outlen) {
+   using hex_detail::decode_table;
+
+   if (s.size() >= 2 && s[0] == '0' && s[1] == 'x')
+      s.remove_prefix(2);
+
+   auto o = static_cast<uint8_t*>(out);
+   size_t n = 0;
+
+   if ((s.size() & 1) && outlen) {
+      const uint8_t v = decode_table[static_cast<uint8_t>(s[0])];
+      if (v == hex_detail::invalid)
+         return hex_npos;
+      o[n++] = v;
+      s.remove_prefix(1);
    }
-   return out_pos - reinterpret_cast<uint8_t*>(out);
+
+   const char* p = s.data();
+   const size_t pairs = std::min(s.size() / 2, outlen - n);
+   o += n;
+
+   size_t i = 0;
+#if EOSTD_HEX_SWAR
+   for (; i + 8 <= pairs; i += 8) {
+      uint64_t a, b;
+      uint32_t lo, hi;
+      std::memcpy(&a, p + 2 * i, 8);
+      std::memcpy(&b, p + 2 * i + 8, 8);
+      if (!hex_detail::decode8(a, lo) || !hex_detail::decode8(b, hi))
+         return hex_npos;
+      std::memcpy(o + i, &lo, 4);
+      std::memcpy(o + i + 4, &hi, 4);
+   }
+#endif
+   uint8_t bad = 0;
+   for (; i < pairs; ++i) {
+      const uint8_t h = decode_table[static_cast<uint8_t>(p[2 * i])];
+      const uint8_t l = decode_table[static_cast<uint8_t>(p[2 * i + 1])];
+      bad |= h | l;
+      o[i] = static_cast<uint8_t>(h << 4 | l);
+   }
+   if (bad & 0xf0)
+      return hex_npos;
+
+   return n + pairs;
 }
 
-std::string to_hex(const std::vector<char>& data) {
-   if (data.size())
-      return to_hex(data.data(), data.size());
-   return "";
+EOSTD_HEX_INLINE size_t from_hex(std::string_view s, char* out, size_t outlen) {
+   const size_t n = try_from_hex(s, out, outlen);
+   if (n == hex_npos) {
+      // slow path, only to name the offending char
+      for (char c : s.substr(s.size() >= 2 && s[0] == '0' && s[1] == 'x' ? 2 : 0))
+         from_hex(c);
+   }
+   return n;
 }
 
+#endif
+
 }
@@ -0,0 +1,202 @@
+/**
+ * @file
+ * Leveled logging that is compiled out below the build's log level
+ *
+ * `tlog`, `dlog` and `ilog` format their arguments into one stack buffer and print it
+ * with a single `prints_l`, instead of one print intrinsic per argument. Levels below
+ * `EOSTD_LOG_LEVEL` compile to nothing; their arguments are still evaluated, so values
+ * that are costly to compute are guarded with `if constexpr (eostd::log_enabled(...))`.
+ */
+#pragma once
+
+#include "symbol.hpp"
+
+#include <eosio/print.hpp>
+
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+/// Lowest level that is logged: 0 trace, 1 debug, 2 info, 3 nothing. Defaults to debug, or nothing with `NDEBUG`.
+#ifndef EOSTD_LOG_LEVEL
+#ifdef NDEBUG
+#define EOSTD_LOG_LEVEL 3
+#else
+#define EOSTD_LOG_LEVEL 1
+#endif
+#endif
+
+/// Bytes formatted before a log is printed; longer messages are printed in several pieces
+#ifndef EOSTD_LOG_BUFFER_SIZE
+#define EOSTD_LOG_BUFFER_SIZE 256
+#endif
+
+namespace eostd {
+
+   enum class log_level : uint8_t {
+      trace,
+      debug,
+      info,
+      off,
+   };
+
+   constexpr log_level min_log_level = static_cast<log_level>(EOSTD_LOG_LEVEL);
+
+   constexpr bool log_enabled(log_level level) { return level >= min_log_level && level != log_level::off; }
+
+   /// a `key=value` pair in a log
+   template<typename T>
+   struct log_field {
+      std::string_view key;
+      const T&         value;
+   };
+
+   template<typename T>
+   log_field<T> field(std::string_view key, const T& value) { return { key, value }; }
+
+   namespace log_detail {
+
+      class buffer {
+      public:
+         ~buffer() { flush(); }
+
+         void flush() {
+            if (_end != _data)
+               eosio::printl(_data, _end - _data);
+            _end = _data;
+         }
+
+         void append(const char* str, size_t size) {
+            for (;;) {
+               const size_t _room = _data + sizeof(_data) - _end;
+               if (size <= _room) {
+                  std::memcpy(_end, str, size);
+                  _end += size;
+                  return;
+               }
+               std::memcpy(_end, str, _room);
+               _end += _room;
+               str += _room;
+               size -= _room;
+               flush();
+            }
+         }
+
+         /// room for `size` more chars, which the caller fills and hands back to `commit`
+         char* reserve(size_t size) {
+            if (static_cast<size_t>(_data + sizeof(_data) - _end) < size)
+               flush();
+            return _end;
+         }
+         void commit(char* end) { _end = end; }
+
+      private:
+         static_assert(EOSTD_LOG_BUFFER_SIZE >= 64, "log buffer cannot hold a 128-bit number");
+
+         char  _data[EOSTD_LOG_BUFFER_SIZE];
+         char* _end = _data;
+      };
+
+      inline void write(buffer& buf, const char* str) { buf.append(str, std::strlen(str)); }
+      inline void write(buffer& buf, std::string_view str) { buf.append(str.data(), str.size()); }
+      inline void write(buffer& buf, char c) { buf.append(&c, 1); }
+      inline void write(buffer& buf, bool b) { write(buf, b ? "true" : "false"); }
+
+      template<typename T, std::enable_if_t<std::is_integral<T>::value, int> = 0>
+      void write(buffer& buf, T value) {
+         using unsigned_type = std::make_unsigned_t<T>;
+         char _digits[40];
+         char* _p = _digits + sizeof(_digits);
+         unsigned_type _v = static_cast<unsigned_type>(value);
+         const bool _negative = std::is_signed<T>::value && value < 0;
+         if (_negative)
+            _v = unsigned_type(0) - _v;
+         do {
+            *--_p = static_cast<char>('0' + _v % 10);
+            _v /= 10;
+         } while (_v);
+         if (_negative)
+            *--_p = '-';
+         buf.append(_p, _digits + sizeof(_digits) - _p);
+      }
+
+      inline void write(buffer& buf, eosio::name n) {
+         char* _p = buf.reserve(13);
+         buf.commit(symbol_detail::write_name(n.value, _p, _p + 13));
+      }
+
+      inline void write(buffer& buf, eosio::symbol_code code) {
+         char* _p = buf.reserve(7);
+         buf.commit(symbol_detail::write_code(code.raw(), _p, _p + 7));
+      }
+
+      inline void write(buffer& buf, const extended_symbol_code& xsym) {
+         constexpr size_t _size = extended_symbol_code::max_string_size;
+         char* _p = buf.reserve(_size);
+         buf.commit(xsym.write_as_string(_p, _p + _size));
+      }
+
+      template<typename T>
+      void format(buffer& buf, const T& value);
+
+      template<typename T>
+      void write(buffer& buf, const log_field<T>& f) {
+         write(buf, f.key);
+         write(buf, '=');
+         format(buf, f.value);
+      }
+
+      template<typename T>
+      using writable = decltype(write(std::declval<buffer&>(), std::declval<const T&>()));
+
+      template<typename T, typename = void>
+      struct is_writable : std::false_type {};
+      template<typename T>
+      struct is_writable<T, std::void_t<writable<T>>> : std::true_type {};
+
+      /// types the buffer cannot format, like floating point, are printed by eosio::print in between
+      template<typename T>
+      void format(buffer& buf, const T& value) {
+         if constexpr (is_writable<T>::value) {
+            write(buf, value);
+         } else {
+            buf.flush();
+            eosio::print(value);
+         }
+      }
+
+   }
+
+   /**
+    * Prints all of `args` with one print intrinsic call
+    * @brief Prints all of `args` with one print intrinsic call
+    *
+    * Strings, chars, bools, integers up to 128 bits, names, symbol codes,
+    * extended_symbol_codes and `field`s are formatted as eosio::print would print them.
+    * Other arguments are printed by eosio::print, costing a call of their own.
+    *
+    * @param args - Values to print, in order
+    */
+   template<typename... Args>
+   void print_buffered(const Args&... args) {
+      log_detail::buffer _buf;
+      (log_detail::format(_buf, args), ...);
+   }
+
+   /// prints `args` as print_buffered does when `Level` is enabled, and compiles to nothing otherwise
+   template<log_level Level, typename... Args>
+   inline void log(const Args&... args) {
+      if constexpr (log_enabled(Level))
+         print_buffered(args...);
+   }
+
+   template<typename... Args>
+   inline void tlog(const Args&... args) { log<log_level::trace>(args...); }
+
+   template<typename... Args>
+   inline void dlog(const Args&... args) { log<log_level::debug>(args...); }
+
+   template<typename... Args>
+   inline void ilog(const Args&... args) { log<log_level::info>(args...); }
+
+}
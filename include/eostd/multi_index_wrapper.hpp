@@ -1,28 +1,387 @@
 #pragma once
 
 #include <eosio/multi_index.hpp>
+#include "table_cache.hpp"
+
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
 namespace eostd {
 
    using namespace eosio;
 
+   namespace multi_index_detail {
+
+      /// steps the primary index with multi_index's own iterators, which load each row as they go
+      template <typename T>
+      struct primary_cursor {
+         using position = typename T::const_iterator;
+
+         static void next(const T&, position& pos) { ++pos; }
+         static void prev(const T&, position& pos) { --pos; }
+         static auto& get(const T&, const position& pos) { return *pos; }
+      };
+
+      /// steps a secondary index with its db iterators, loading a row only when it is read
+      template <typename T, eosio::name::raw IndexName>
+      struct secondary_cursor {
+         using index_type = decltype(std::declval<const T&>().template get_index<IndexName>());
+         using key_type   = typename index_type::secondary_key_type;
+         using db_index   = eosio::_multi_index_detail::secondary_index_db_functions<key_type>;
+
+         struct position {
+            int32_t  itr;
+            uint64_t pk;
+
+            friend bool operator==(const position& a, const position& b) { return a.itr == b.itr; }
+            friend bool operator!=(const position& a, const position& b) { return a.itr != b.itr; }
+         };
+
+         static void next(const T&, position& pos) {
+            pos.itr = db_index::db_idx_next(pos.itr, &pos.pk);
+         }
+         static void prev(const T&, position& pos) {
+            eosio::check(pos.itr != -1, "cannot decrement end iterator when the index is empty");
+            pos.itr = db_index::db_idx_previous(pos.itr, &pos.pk);
+            eosio::check(pos.itr >= 0, "cannot decrement iterator at beginning of index");
+         }
+         static auto& get(const T& tbl, const position& pos) { return *tbl.find(pos.pk); }
+
+         static position lower_bound(const T& tbl, key_type key) {
+            position pos{ -1, 0 };
+            pos.itr = db_index::db_idx_lowerbound(tbl.get_code().value, tbl.get_scope(), index_type::name(), key, pos.pk);
+            return pos;
+         }
+         static position upper_bound(const T& tbl, key_type key) {
+            position pos{ -1, 0 };
+            pos.itr = db_index::db_idx_upperbound(tbl.get_code().value, tbl.get_scope(), index_type::name(), key, pos.pk);
+            return pos;
+         }
+         static position end(const T& tbl) {
+            return { db_index::db_idx_end(tbl.get_code().value, tbl.get_scope(), index_type::name()), 0 };
+         }
+      };
+
+      /**
+       * Walks the primary index from `itr` over at most `max_rows` rows, stopping early at
+       * the first row `in_range` rejects, and erases the rows `pred` accepts
+       *
+       * @return typename T::const_iterator - First row not visited
+       */
+      template <typename T, typename InRange, typename Pred>
+      typename T::const_iterator erase_primary(T& tbl, typename T::const_iterator itr, uint64_t max_rows,
+                                               InRange&& in_range, Pred&& pred, uint64_t& erased) {
+         for (; max_rows && itr != tbl.end() && in_range(*itr); --max_rows) {
+            if (pred(*itr)) {
+               itr = tbl.erase(itr);
+               ++erased;
+            } else {
+               ++itr;
+            }
+         }
+         return itr;
+      }
+
+      struct any_row {
+         template <typename Row>
+         bool operator()(const Row&)const { return true; }
+      };
+
+      /// the table of (code, scope), shared through table_cache or opened in `own`, with the writes held back from it made
+      template <typename T>
+      cached_table<T>& open_table(std::optional<cached_table<T>>& own, bool shared, eosio::name code, eosio::name scope) {
+         held_writes<T>::write(code, scope.value);
+         if (shared)
+            return table_cache<T>::open(code, scope.value);
+         return own.emplace(code, scope.value);
+      }
+
+   }
+
+   /**
+    * Rows of a table from `first` up to, not including, `last`, in index order or reversed
+    *
+    * The bounds are fixed when the range is made; each step is one db call, plus the
+    * loads of the rows that are read.
+    */
+   template <typename T, typename Cursor>
+   class table_range {
+   public:
+      using position = typename Cursor::position;
+
+      class iterator {
+      public:
+         using value_type        = std::decay_t<decltype(Cursor::get(std::declval<const T&>(), std::declval<const position&>()))>;
+         using iterator_category = std::forward_iterator_tag;
+         using difference_type   = std::ptrdiff_t;
+         using pointer           = const value_type*;
+         using reference         = const value_type&;
+
+         reference operator*()const { return Cursor::get(*_tbl, _pos); }
+         pointer operator->()const { return &Cursor::get(*_tbl, _pos); }
+
+         iterator& operator++() {
+            if (!_reverse)
+               Cursor::next(*_tbl, _pos);
+            else if (_pos == _first)
+               _pos = _last;
+            else
+               Cursor::prev(*_tbl, _pos);
+            return (*this);
+         }
+         iterator operator++(int) { iterator _prev = *this; ++(*this); return _prev; }
+
+         friend bool operator==(const iterator& a, const iterator& b) { return a._pos == b._pos; }
+         friend bool operator!=(const iterator& a, const iterator& b) { return !(a._pos == b._pos); }
+
+      private:
+         friend class table_range;
+
+         iterator(const T* tbl, position pos, position first, position last, bool reverse)
+         : _tbl(tbl), _pos(pos), _first(first), _last(last), _reverse(reverse)
+         {}
+
+         const T* _tbl;
+         position _pos;
+         position _first;
+         position _last;
+         bool     _reverse;
+      };
+
+      table_range(const T& tbl, position first, position last, bool reverse = false)
+      : _tbl(&tbl), _first(first), _last(last), _reverse(reverse)
+      {}
+
+      iterator begin()const {
+         position _pos = _reverse ? _last : _first;
+         if (_reverse && !empty())
+            Cursor::prev(*_tbl, _pos);
+         return iterator(_tbl, _pos, _first, _last, _reverse);
+      }
+      iterator end()const { return iterator(_tbl, _last, _first, _last, _reverse); }
+
+      bool empty()const { return _first == _last; }
+
+      /// the same rows, walked from the last one back
+      table_range reverse()const { return table_range(*_tbl, _first, _last, !_reverse); }
+
+   private:
+      const T* _tbl;
+      position _first;
+      position _last;
+      bool     _reverse;
+   };
+
+   /// tag type of `no_lookup`
+   struct no_lookup_t {
+      explicit no_lookup_t() = default;
+   };
+
+   /**
+    * Constructs a wrapper past the last row without looking anything up, for wrappers
+    * that are only used to emplace: `multi_index_wrapper<T> w(code, scope, no_lookup);`
+    */
+   inline constexpr no_lookup_t no_lookup{};
+
+   /// tag type of `shared_table`
+   struct shared_table_t {
+      explicit shared_table_t() = default;
+   };
+
+   /**
+    * Constructs a wrapper on the multi_index that every wrapper of its (code, scope) made
+    * with this tag shares, see table_cache: `multi_index_wrapper<T> w(shared_table, code, scope, key);`
+    */
+   inline constexpr shared_table_t shared_table{};
+
    template <typename T, eosio::name::raw IndexName = name(), typename Extractor = uint64_t>
    class multi_index_wrapper {
    protected:
-      T                          _tbl;
-      typename T::const_iterator _this;
+      using cursor     = multi_index_detail::secondary_cursor<T, IndexName>;
+      using index_type = typename cursor::index_type;
+      using key_type   = typename cursor::key_type;
+      using db_index   = typename cursor::db_index;
+
+      /// `_itr` value after emplace, until a step needs the secondary iterator of the new row
+      static constexpr int32_t _unresolved = std::numeric_limits<int32_t>::min();
+
+      /// `_itr` value until the key given to the constructor is looked up
+      static constexpr int32_t _unsearched = _unresolved + 1;
+
+      std::optional<cached_table<T>>     _own;   ///< the table, unless it is shared
+      cached_table<T>&                   _cached;
+      T&                                 _tbl;
+      mutable uint64_t                   _erasures;
+      mutable typename T::const_iterator _this;
+      mutable bool                       _loaded;
+      mutable uint64_t                   _pk;
+      mutable int32_t                    _itr;
+      Extractor                          _key;
+
+      /**
+       * Other wrappers on the shared table may have erased the current row, which frees
+       * the loaded row and ends its db iterator, so once they have erased anything the
+       * row is found again by primary key. A wrapper whose row is gone is past the end.
+       */
+      void recheck()const {
+         if (_erasures == _cached.erasures)
+            return;
+         _erasures = _cached.erasures;
+         if (_itr < 0 && _itr != _unresolved)
+            return;
+         _this = _tbl.find(_pk);
+         _loaded = true;
+         _itr = _this != _tbl.end() ? _unresolved : -1;
+      }
+
+      /// counts the rows this wrapper erased, once it is on a row that is left
+      void erased(uint64_t rows) {
+         _cached.erasures += rows;
+         _erasures = _cached.erasures;
+      }
+
+      /// makes the writes other wrappers hold back from the table, before it is read
+      void write_held()const { held_writes<T>::write(_tbl.get_code(), _tbl.get_scope()); }
+
+      /// looks the constructor's key up the first time the position is needed
+      int32_t current()const {
+         write_held();
+         recheck();
+         if (_itr == _unsearched)
+            _itr = db_index::db_idx_find_secondary(code().value, _tbl.get_scope(), index_type::name(), _key, _pk);
+         return _itr;
+      }
+
+      /**
+       * The wrapper walks the secondary index with its own db iterator and only
+       * loads the primary row, through `_tbl.find`, when it is first used
+       */
+      typename T::const_iterator row()const {
+         write_held();
+         recheck();
+         if (!_loaded) {
+            _this = exists() ? _tbl.find(_pk) : _tbl.end();
+            _loaded = true;
+         }
+         return _this;
+      }
+
+      int32_t secondary() {
+         if (current() == _unresolved) {
+            key_type _key;
+            _itr = db_index::db_idx_find_primary(code().value, _tbl.get_scope(), index_type::name(), _pk, _key);
+         }
+         return _itr;
+      }
+
+      void seek(int32_t itr) {
+         _itr = itr;
+         _loaded = false;
+         _erasures = _cached.erasures;
+      }
+
+      /**
+       * Walks the index from `pos` over at most `max_rows` rows, up to `last` or the end,
+       * erasing the rows `pred` accepts, and moves to the first row not visited
+       *
+       * The next position is taken before a row is erased, so each step is one db call and
+       * rows are erased by value, without multi_index stepping the primary index as well.
+       */
+      template<typename Pred>
+      uint64_t erase_walk(typename cursor::position pos, typename cursor::position last, uint64_t max_rows, Pred&& pred) {
+         uint64_t _erased = 0;
+         for (; max_rows && pos.itr >= 0 && pos != last; --max_rows) {
+            auto _next = pos;
+            cursor::next(_tbl, _next);
+            const auto& _row = *_tbl.find(pos.pk);
+            if (pred(_row)) {
+               _tbl.erase(_row);
+               ++_erased;
+            }
+            pos = _next;
+         }
+         _pk = pos.pk;
+         seek(pos.itr);
+         erased(_erased);
+         return _erased;
+      }
+
+      /// erase_range, erasing only the rows `pred` accepts
+      template<typename Pred>
+      uint64_t erase_range_if(const key_type& lo, const key_type& hi, Pred&& pred, uint64_t max_rows) {
+         auto _last = cursor::lower_bound(_tbl, hi);
+         return erase_walk(lo < hi ? cursor::lower_bound(_tbl, lo) : _last, _last, max_rows, std::forward<Pred>(pred));
+      }
+
+      /// clear_scope, erasing only the rows `pred` accepts
+      template<typename Pred>
+      uint64_t clear_scope_if(Pred&& pred, uint64_t max_rows) {
+         uint64_t _erased = 0;
+         multi_index_detail::erase_primary(_tbl, _tbl.cbegin(), max_rows, multi_index_detail::any_row(),
+                                           std::forward<Pred>(pred), _erased);
+         lower_bound(eosio::_multi_index_detail::secondary_key_traits<key_type>::true_lowest());
+         erased(_erased);
+         return _erased;
+      }
+
+      multi_index_wrapper(bool shared, name code, name scope, Extractor key, bool lookup)
+      : _cached(multi_index_detail::open_table(_own, shared, code, scope))
+      , _tbl(_cached.table)
+      , _erasures(_cached.erasures)
+      , _this(_tbl.end())
+      , _loaded(!lookup)
+      , _pk(0)
+      , _itr(lookup ? _unsearched : -1)
+      , _key(key)
+      {}
 
    public:
+      using range_type = table_range<T, cursor>;
+
+      /**
+       * Wrapper on the first row whose `IndexName` key is `key`
+       * @brief Wrapper on the first row whose `IndexName` key is `key`
+       *
+       * The key is looked up when the position is first needed, by `exists()`,
+       * `operator->`, `modify` or a step, not here. Wrappers that only emplace, or only
+       * reach the table through `table()` and `get_index()`, never look it up.
+       *
+       * The wrapper opens a multi_index of its own, which loads the rows it reads again
+       * and does not see writes through other wrappers to rows it has already loaded.
+       * Made with `shared_table`, it shares one with the other such wrappers of (code,
+       * scope) instead, see table_cache. Rows erased through one of those are noticed by
+       * the others; rows erased through `get_index()` are not, so wrappers on them must
+       * not be used afterwards.
+       *
+       * @param code - Contract that owns the table
+       * @param scope - Scope of the table
+       * @param key - `IndexName` key to find
+       */
       multi_index_wrapper(name code, name scope,
                        Extractor key = eosio::_multi_index_detail::secondary_key_traits<Extractor>::true_lowest())
-      : _tbl(code, scope.value)
-      , _this(_tbl.end())
-      {
-         auto _idx = _tbl.template get_index<IndexName>();
-         auto _it  = _idx.find(key);
-         if (_it != _idx.end())
-            _this = _tbl.find(_it->primary_key());
-      }
+      : multi_index_wrapper(false, code, scope, key, true)
+      {}
+
+      /// wrapper past the last row, made without a db call
+      multi_index_wrapper(name code, name scope, no_lookup_t)
+      : multi_index_wrapper(false, code, scope, Extractor(), false)
+      {}
+
+      /// the same wrappers on the shared multi_index of (code, scope)
+      multi_index_wrapper(shared_table_t, name code, name scope,
+                       Extractor key = eosio::_multi_index_detail::secondary_key_traits<Extractor>::true_lowest())
+      : multi_index_wrapper(true, code, scope, key, true)
+      {}
+      multi_index_wrapper(shared_table_t, name code, name scope, no_lookup_t)
+      : multi_index_wrapper(true, code, scope, Extractor(), false)
+      {}
+
+      // a copy would keep using the table of the wrapper it was copied from
+      multi_index_wrapper(const multi_index_wrapper&) = delete;
+      multi_index_wrapper& operator=(const multi_index_wrapper&) = delete;
 
       const T& table()const { return _tbl; }
       auto index()const { return _tbl.template get_index<IndexName>(); }
@@ -30,86 +389,301 @@ namespace eostd {
       template <eosio::name::raw SecondaryIndex>
       auto get_index() { return _tbl.template get_index<SecondaryIndex>(); }
 
-      bool exists()const { return _this != _tbl.end(); }
+      bool exists()const { return current() >= 0 || _itr == _unresolved; }
       operator bool()const { return exists(); }
 
       inline name code()const  { return _tbl.get_code(); }
       inline name scope()const { return name(_tbl.get_scope()); }
 
-      const typename T::const_iterator operator->()const { return _this; }
+      const typename T::const_iterator operator->()const { return row(); }
 
-      multi_index_wrapper operator++()    {
-         auto _idx = index();
-         auto _it = _idx.iterator_to(*_this);
-         if (++_it != _idx.end())
-            _this = _tbl.find(_it->primary_key());
-         else
-            _this = _tbl.end();
+      multi_index_wrapper& operator++()    {
+         eosio::check(exists(), "cannot increment end iterator");
+         seek(db_index::db_idx_next(secondary(), &_pk));
+         return (*this);
+      }
+      /// steps forward and returns the row it left
+      typename T::const_iterator operator++(int) { auto _prev = row(); ++(*this); return _prev; }
+      multi_index_wrapper& operator--()    {
+         int32_t _prev = exists() ? secondary() : db_index::db_idx_end(code().value, _tbl.get_scope(), index_type::name());
+         eosio::check(_prev != -1, "cannot decrement end iterator when the index is empty");
+         _prev = db_index::db_idx_previous(_prev, &_pk);
+         eosio::check(_prev >= 0, "cannot decrement iterator at beginning of index");
+         seek(_prev);
          return (*this);
       }
-      multi_index_wrapper operator++(int) { return ++(*this); }
-      multi_index_wrapper operator--()    {
-         auto _idx = index();
-         auto _it = _idx.iterator_to(*_this);
-         if (--_it != _idx.end())
-            _this = _tbl.find(_it->primary_key());
+      /// steps back and returns the row it left
+      typename T::const_iterator operator--(int) { auto _prev = row(); --(*this); return _prev; }
+
+      /// moves to the first row whose `IndexName` key is not less than `key`
+      multi_index_wrapper& lower_bound(const key_type& key) {
+         auto _pos = cursor::lower_bound(_tbl, key);
+         _pk = _pos.pk;
+         seek(_pos.itr);
          return (*this);
       }
-      multi_index_wrapper operator--(int) { return --(*this); }
+
+      /// moves to the first row whose `IndexName` key is greater than `key`
+      multi_index_wrapper& upper_bound(const key_type& key) {
+         auto _pos = cursor::upper_bound(_tbl, key);
+         _pk = _pos.pk;
+         seek(_pos.itr);
+         return (*this);
+      }
+
+      /**
+       * Rows with `lo <= key < hi` in `IndexName` order
+       * @brief Rows with `lo <= key < hi` in `IndexName` order
+       *
+       * `for (const auto& row : wrapper.range(lo, hi))` costs two bound lookups, then one
+       * db call per step besides loading the rows read. Use `.reverse()` to walk it back.
+       * The range reads the wrapper's table, so it cannot be taken from a temporary wrapper.
+       *
+       * @param lo - Lowest key in the range
+       * @param hi - Key past the range
+       * @return range_type - Forward range over the rows
+       */
+      range_type range(const key_type& lo, const key_type& hi)const& {
+         write_held();
+         auto _last = cursor::lower_bound(_tbl, hi);
+         return range_type(_tbl, lo < hi ? cursor::lower_bound(_tbl, lo) : _last, _last);
+      }
+      range_type range(const key_type& lo)const& {
+         write_held();
+         return range_type(_tbl, cursor::lower_bound(_tbl, lo), cursor::end(_tbl));
+      }
+      range_type range()const& { return range(eosio::_multi_index_detail::secondary_key_traits<key_type>::true_lowest()); }
+
+      range_type range(const key_type&, const key_type&)&& = delete;
+      range_type range(const key_type&)&& = delete;
+      range_type range()&& = delete;
+
+      /**
+       * Erases the rows with `lo <= key < hi` in `IndexName` order
+       * @brief Erases the rows with `lo <= key < hi` in `IndexName` order
+       *
+       * The index is walked once, at a cost of two bound lookups and one db call per row
+       * besides the erase. At most `max_rows` rows are erased, so a large range can be
+       * cleared over several transactions; the wrapper is left on the first row kept.
+       *
+       * @param lo - Lowest key to erase
+       * @param hi - Key past the rows to erase
+       * @param max_rows - Most rows to erase
+       * @return uint64_t - Rows erased; fewer than `max_rows` means the range is empty
+       */
+      uint64_t erase_range(const key_type& lo, const key_type& hi, uint64_t max_rows = std::numeric_limits<uint64_t>::max()) {
+         return erase_range_if(lo, hi, multi_index_detail::any_row(), max_rows);
+      }
+
+      /**
+       * Erases the rows `pred` accepts, from the current row on in `IndexName` order
+       * @brief Erases the rows `pred` accepts, from the current row on
+       *
+       * At most `max_rows` rows are visited, erased or not, and the wrapper is left on the
+       * first row not visited, so the next transaction can carry on from its key.
+       *
+       * @param pred - `bool(const row&)`, true for rows to erase
+       * @param max_rows - Most rows to visit
+       * @return uint64_t - Rows erased
+       */
+      template<typename Pred>
+      uint64_t erase_if(Pred&& pred, uint64_t max_rows) {
+         if (!exists())
+            return 0;
+         return erase_walk({ secondary(), _pk }, { -1, 0 }, max_rows, std::forward<Pred>(pred));
+      }
+
+      /**
+       * Erases up to `max_rows` rows of the scope, walking the primary index, and moves to
+       * the first row left in `IndexName` order
+       * @return uint64_t - Rows erased; fewer than `max_rows` means the scope is empty
+       */
+      uint64_t clear_scope(uint64_t max_rows) { return clear_scope_if(multi_index_detail::any_row(), max_rows); }
 
       template<typename Lambda>
       void emplace(name payer, Lambda&& updater) {
          _this = _tbl.emplace(payer, std::forward<Lambda&&>(updater));
+         _loaded = true;
+         _pk = _this->primary_key();
+         _itr = _unresolved;
+         _erasures = _cached.erasures;
       }
 
       template<typename Lambda>
       void modify(name payer, Lambda&& updater) {
-         _tbl.modify(_this, payer, std::forward<Lambda&&>(updater));
+         _tbl.modify(row(), payer, std::forward<Lambda&&>(updater));
       }
 
-      void erase() { _this = _tbl.erase(_this); }
+      /// erases the current row and moves to the next one in `IndexName` order
+      void erase() {
+         eosio::check(exists(), "cannot pass end iterator to erase");
+         uint64_t _next_pk = 0;
+         const int32_t _next = db_index::db_idx_next(secondary(), &_next_pk);
+         _tbl.erase(row());
+         _pk = _next_pk;
+         seek(_next);
+         erased(1);
+      }
    };
 
    template <typename T>
    class multi_index_wrapper<T> {
    protected:
-      T                          _tbl;
-      typename T::const_iterator _this;
+      using cursor = multi_index_detail::primary_cursor<T>;
+
+      std::optional<cached_table<T>>     _own;   ///< the table, unless it is shared
+      cached_table<T>&                   _cached;
+      T&                                 _tbl;
+      mutable uint64_t                   _erasures;
+      mutable typename T::const_iterator _this;
+      mutable bool                       _searched;
+      uint64_t                           _pk;   ///< of the current row; until it is searched, the key to find
+
+      /// finds the constructor's key the first time the position is needed, and the
+      /// current row again after other wrappers erased rows, as in the indexed variant
+      typename T::const_iterator& current()const {
+         write_held();
+         if (_erasures != _cached.erasures) {
+            _erasures = _cached.erasures;
+            if (_searched && _this != _tbl.end())
+               _this = _tbl.find(_pk);
+         }
+         if (!_searched) {
+            _this = _tbl.find(_pk);
+            _searched = true;
+         }
+         return _this;
+      }
+
+      void seek(typename T::const_iterator itr) {
+         _this = itr;
+         _searched = true;
+         _pk = itr != _tbl.end() ? itr->primary_key() : 0;
+         _erasures = _cached.erasures;
+      }
+
+      void erased(uint64_t rows) {
+         _cached.erasures += rows;
+         _erasures = _cached.erasures;
+      }
+
+      void write_held()const { held_writes<T>::write(_tbl.get_code(), _tbl.get_scope()); }
+
+      /// erase_range, erasing only the rows `pred` accepts
+      template<typename Pred>
+      uint64_t erase_range_if(uint64_t lo, uint64_t hi, Pred&& pred, uint64_t max_rows) {
+         uint64_t _erased = 0;
+         seek(multi_index_detail::erase_primary(_tbl, _tbl.lower_bound(lo), max_rows,
+            [hi](const auto& _row) { return _row.primary_key() < hi; }, std::forward<Pred>(pred), _erased));
+         erased(_erased);
+         return _erased;
+      }
+
+      /// clear_scope, erasing only the rows `pred` accepts
+      template<typename Pred>
+      uint64_t clear_scope_if(Pred&& pred, uint64_t max_rows) {
+         uint64_t _erased = 0;
+         seek(multi_index_detail::erase_primary(_tbl, _tbl.cbegin(), max_rows, multi_index_detail::any_row(),
+                                                std::forward<Pred>(pred), _erased));
+         erased(_erased);
+         return _erased;
+      }
+
+      multi_index_wrapper(bool shared, name code, name scope, uint64_t key, bool lookup)
+      : _cached(multi_index_detail::open_table(_own, shared, code, scope))
+      , _tbl(_cached.table)
+      , _erasures(_cached.erasures)
+      , _this(_tbl.end())
+      , _searched(!lookup)
+      , _pk(key)
+      {}
 
    public:
+      using range_type = table_range<T, cursor>;
+
+      /// wrapper on the row with primary key `key`, found when first needed as in the indexed variant
       multi_index_wrapper(name code, name scope, uint64_t key = std::numeric_limits<uint64_t>::lowest())
-      : _tbl(code, scope.value)
-      , _this(_tbl.find(key))
+      : multi_index_wrapper(false, code, scope, key, true)
+      {}
+
+      /// wrapper past the last row, made without a db call
+      multi_index_wrapper(name code, name scope, no_lookup_t)
+      : multi_index_wrapper(false, code, scope, 0, false)
+      {}
+
+      /// the same wrappers on the shared multi_index of (code, scope), as in the indexed variant
+      multi_index_wrapper(shared_table_t, name code, name scope, uint64_t key = std::numeric_limits<uint64_t>::lowest())
+      : multi_index_wrapper(true, code, scope, key, true)
+      {}
+      multi_index_wrapper(shared_table_t, name code, name scope, no_lookup_t)
+      : multi_index_wrapper(true, code, scope, 0, false)
       {}
 
+      multi_index_wrapper(const multi_index_wrapper&) = delete;
+      multi_index_wrapper& operator=(const multi_index_wrapper&) = delete;
+
       const T& table()const { return _tbl; }
 
       template <eosio::name::raw SecondaryIndex>
       auto get_index() { return _tbl.template get_index<SecondaryIndex>(); }
 
-      bool exists()const { return _this != _tbl.end(); }
+      bool exists()const { return current() != _tbl.end(); }
       operator bool()const { return exists(); }
 
       inline name code()const  { return _tbl.get_code(); }
       inline name scope()const { return name(_tbl.get_scope()); }
 
-      const typename T::const_iterator operator->()const { return _this; }
+      const typename T::const_iterator operator->()const { return current(); }
+
+      multi_index_wrapper& operator++()    { auto _next = current(); seek(++_next); return (*this); }
+      typename T::const_iterator operator++(int) { auto _prev = current(); ++(*this); return _prev; }
+      multi_index_wrapper& operator--()    { auto _prev = current(); seek(--_prev); return (*this); }
+      typename T::const_iterator operator--(int) { auto _prev = current(); --(*this); return _prev; }
 
-      multi_index_wrapper operator++()    { ++_this; return (*this); }
-      multi_index_wrapper operator++(int) { return ++(*this); }
-      multi_index_wrapper operator--()    { --_this; return (*this); }
-      multi_index_wrapper operator--(int) { return --(*this); }
+      multi_index_wrapper& lower_bound(uint64_t key) { seek(_tbl.lower_bound(key)); return (*this); }
+      multi_index_wrapper& upper_bound(uint64_t key) { seek(_tbl.upper_bound(key)); return (*this); }
+
+      /// rows with `lo <= primary key < hi`, see the indexed variant
+      range_type range(uint64_t lo, uint64_t hi)const& {
+         write_held();
+         auto _last = _tbl.lower_bound(hi);
+         return range_type(_tbl, lo < hi ? _tbl.lower_bound(lo) : _last, _last);
+      }
+      range_type range(uint64_t lo)const& { write_held(); return range_type(_tbl, _tbl.lower_bound(lo), _tbl.end()); }
+      range_type range()const& { write_held(); return range_type(_tbl, _tbl.begin(), _tbl.end()); }
+
+      range_type range(uint64_t, uint64_t)&& = delete;
+      range_type range(uint64_t)&& = delete;
+      range_type range()&& = delete;
+
+      /// erases the rows with `lo <= primary key < hi`, see the indexed variant
+      uint64_t erase_range(uint64_t lo, uint64_t hi, uint64_t max_rows = std::numeric_limits<uint64_t>::max()) {
+         return erase_range_if(lo, hi, multi_index_detail::any_row(), max_rows);
+      }
+
+      /// erases the rows `pred` accepts from the current row on, visiting at most `max_rows`
+      template<typename Pred>
+      uint64_t erase_if(Pred&& pred, uint64_t max_rows) {
+         uint64_t _erased = 0;
+         seek(multi_index_detail::erase_primary(_tbl, current(), max_rows, multi_index_detail::any_row(),
+                                                std::forward<Pred>(pred), _erased));
+         erased(_erased);
+         return _erased;
+      }
+
+      /// erases up to `max_rows` rows of the scope and moves to the first row left
+      uint64_t clear_scope(uint64_t max_rows) { return clear_scope_if(multi_index_detail::any_row(), max_rows); }
 
       template<typename Lambda>
       void emplace(name payer, Lambda&& updater) {
-         _this = _tbl.emplace(payer, std::forward<Lambda&&>(updater));
+         seek(_tbl.emplace(payer, std::forward<Lambda&&>(updater)));
       }
 
       template<typename Lambda>
       void modify(name payer, Lambda&& updater) {
-         _tbl.modify(_this, payer, std::forward<Lambda&&>(updater));
+         _tbl.modify(current(), payer, std::forward<Lambda&&>(updater));
       }
 
-      void erase() { _this = _tbl.erase(_this); }
+      void erase() { seek(_tbl.erase(current())); erased(1); }
    };
 }
@@ -0,0 +1,81 @@
+/**
+ * @file
+ * Control of the in-memory database behind the native build's db intrinsics
+ *
+ * When eostd is built with `EOSTD_NATIVE`, the primary `db_*_i64` intrinsics and the
+ * idx64, idx128 and idx_double secondary index intrinsics are served from memory, so
+ * multi_index and the wrappers run unchanged on the host. Every call is counted, per
+ * action and in total.
+ */
+#pragma once
+
+#include <eosio/name.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+/// X(intrinsic) for every db intrinsic the native build serves
+#define EOSTD_NATIVE_DB_SECONDARY_INTRINSICS(X, IDX) \
+   X(db_##IDX##_store) X(db_##IDX##_update) X(db_##IDX##_remove) X(db_##IDX##_next) X(db_##IDX##_previous) \
+   X(db_##IDX##_find_primary) X(db_##IDX##_find_secondary) X(db_##IDX##_lowerbound) X(db_##IDX##_upperbound) X(db_##IDX##_end)
+
+#define EOSTD_NATIVE_DB_INTRINSICS(X) \
+   X(db_store_i64) X(db_update_i64) X(db_remove_i64) X(db_get_i64) X(db_next_i64) X(db_previous_i64) \
+   X(db_find_i64) X(db_lowerbound_i64) X(db_upperbound_i64) X(db_end_i64) \
+   EOSTD_NATIVE_DB_SECONDARY_INTRINSICS(X, idx64) \
+   EOSTD_NATIVE_DB_SECONDARY_INTRINSICS(X, idx128) \
+   EOSTD_NATIVE_DB_SECONDARY_INTRINSICS(X, idx_double)
+
+namespace eostd { namespace native {
+
+   enum class db_intrinsic : uint8_t {
+#define EOSTD_NATIVE_DB_ENUM(name) name,
+      EOSTD_NATIVE_DB_INTRINSICS(EOSTD_NATIVE_DB_ENUM)
+#undef EOSTD_NATIVE_DB_ENUM
+      count
+   };
+
+   /// the intrinsic's name, e.g. "db_find_i64"
+   const char* to_string(db_intrinsic intrinsic);
+
+   /// calls per db intrinsic
+   struct db_call_counts {
+      uint64_t calls[static_cast<size_t>(db_intrinsic::count)] = {};
+
+      uint64_t operator[](db_intrinsic intrinsic)const { return calls[static_cast<size_t>(intrinsic)]; }
+
+      uint64_t total()const {
+         uint64_t _total = 0;
+         for (auto _calls : calls)
+            _total += _calls;
+         return _total;
+      }
+   };
+
+   /**
+    * Starts a new action run by `receiver`
+    *
+    * Like on chain, db iterators and contract memory do not carry over: iterators from
+    * the previous action are invalid, table caches are cleared, and the per-action counts
+    * start from zero. Tables keep their rows.
+    *
+    * @param receiver - Contract the action runs in; only its tables can be written
+    */
+   void db_begin_action(eosio::name receiver);
+
+   /// drops every table and zeroes all counts; the receiver is kept
+   void db_reset();
+
+   /// calls made in the current action
+   const db_call_counts& db_action_calls();
+
+   /// calls made since the last db_reset()
+   const db_call_counts& db_total_calls();
+
+   /// actions begun since the last db_reset()
+   uint64_t db_actions();
+
+   /// prints every intrinsic that was called, with its count
+   void db_print_calls(const db_call_counts& counts);
+
+} } /// namespace eostd::native
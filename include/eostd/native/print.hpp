@@ -0,0 +1,25 @@
+/**
+ * @file
+ * Control of the print intrinsics in the native build
+ *
+ * When eostd is built with `EOSTD_NATIVE`, the print intrinsics write to stdout and
+ * count their calls. Printed text can be captured instead, e.g. to compare output.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace eostd { namespace native {
+
+   /// calls of any print intrinsic since the process started
+   uint64_t print_calls();
+
+   /**
+    * Sends printed text to `sink` instead of stdout
+    *
+    * @param sink - String the text is appended to, or nullptr to print to stdout again
+    */
+   void capture_prints(std::string* sink);
+
+} } /// namespace eostd::native
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace eostd {
+
+   /**
+    * Pointer and size over contiguous elements, for C++17 builds without std::span
+    *
+    * Converts from arrays and from anything with `data()` and `size()`: std::vector,
+    * std::array, std::string, std::span, small_bytes, or a span of non-const elements.
+    */
+   template<typename T>
+   class span {
+   public:
+      using element_type = T;
+      using value_type   = std::remove_cv_t<T>;
+      using iterator     = T*;
+
+      static constexpr size_t npos = static_cast<size_t>(-1);
+
+      constexpr span() = default;
+      constexpr span(T* data, size_t size) : _data(data), _size(size) {}
+
+      template<size_t N>
+      constexpr span(T (&arr)[N]) : _data(arr), _size(N) {}
+
+      template<typename Container, typename = std::enable_if_t<
+         !std::is_same<std::decay_t<Container>, span>::value &&
+         std::is_convertible<decltype(std::declval<Container&>().data()), T*>::value>>
+      constexpr span(Container&& c) : _data(c.data()), _size(c.size()) {}
+
+      constexpr T* data()const { return _data; }
+      constexpr size_t size()const { return _size; }
+      constexpr bool empty()const { return _size == 0; }
+
+      constexpr T* begin()const { return _data; }
+      constexpr T* end()const { return _data + _size; }
+
+      constexpr T& operator[](size_t i)const { return _data[i]; }
+
+      constexpr span first(size_t count)const { return { _data, count }; }
+      constexpr span last(size_t count)const { return { _data + _size - count, count }; }
+      constexpr span subspan(size_t offset, size_t count = npos)const {
+         return { _data + offset, count == npos ? _size - offset : count };
+      }
+
+   private:
+      T*     _data = nullptr;
+      size_t _size = 0;
+   };
+
+}
@@ -3,11 +3,138 @@
 #include <eosio/symbol.hpp>
 #include <eosio/print.hpp>
 
+#include <array>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
 namespace eostd {
 
    using eosio::symbol_code;
    using eosio::name;
 
+   /// why a string is not a valid "CODE@contract" pair
+   enum class xsym_error : uint8_t {
+      none,
+      missing_separator,   ///< there is no '@'
+      invalid_code,        ///< the symbol code is empty, longer than 7 chars, or not all A-Z
+      invalid_contract,    ///< the contract is empty or not a valid account name
+   };
+
+   namespace symbol_detail {
+
+      constexpr uint8_t invalid_name_char = 0x20;
+
+      constexpr std::array<uint8_t, 256> make_name_table() {
+         std::array<uint8_t, 256> t{};
+         for (int c = 0; c < 256; ++c) {
+            if (c == '.')
+               t[c] = 0;
+            else if (c >= '1' && c <= '5')
+               t[c] = c - '1' + 1;
+            else if (c >= 'a' && c <= 'z')
+               t[c] = c - 'a' + 6;
+            else
+               t[c] = invalid_name_char;
+         }
+         return t;
+      }
+
+      constexpr std::array<uint8_t, 256> make_code_table() {
+         std::array<uint8_t, 256> t{};
+         for (int c = 'A'; c <= 'Z'; ++c)
+            t[c] = c;
+         return t;
+      }
+
+      /// 5-bit name value of every char, `invalid_name_char` for chars a name cannot hold
+      inline constexpr std::array<uint8_t, 256> name_table = make_name_table();
+
+      /// the char itself for A-Z, 0 for chars a symbol code cannot hold
+      inline constexpr std::array<uint8_t, 256> code_table = make_code_table();
+
+      /**
+       * Validates and packs "CODE@contract" in one pass
+       *
+       * Chars are validated by table lookup, and the results are or-ed together and looked
+       * at once per half, so the only branch per char is the test for '@'. The code half
+       * is at most 7 chars, so an '@' further in is only searched for to tell a missing
+       * separator from an overlong code. Packing matches symbol_code(std::string_view) and
+       * name(std::string_view).
+       */
+      constexpr xsym_error parse(std::string_view str, uint64_t& code_raw, uint64_t& contract_raw) {
+         const size_t size = str.size();
+         const size_t limit = size < 8 ? size : 8;
+
+         uint64_t code = 0, bad = 0;
+         size_t at = 0;
+         for (; at < limit && str[at] != '@'; ++at) {
+            const uint64_t v = code_table[static_cast<uint8_t>(str[at])];
+            code |= v << (at * 8);
+            bad |= v == 0;
+         }
+         if (at == size || (at == 8 && str.find('@', 8) == std::string_view::npos))
+            return xsym_error::missing_separator;
+         if (bad | (at - 1 > 6))   // wraps around when the code is empty
+            return xsym_error::invalid_code;
+
+         const char* name_str = str.data() + at + 1;
+         const size_t name_size = size - at - 1;
+         if (name_size - 1 > 12)
+            return xsym_error::invalid_contract;
+
+         const size_t n = name_size < 12 ? name_size : 12;
+         uint64_t contract = 0;
+         for (size_t i = 0; i < n; ++i) {
+            const uint64_t v = name_table[static_cast<uint8_t>(name_str[i])];
+            contract = contract << 5 | (v & 0x1f);
+            bad |= v;
+         }
+         contract <<= 4 + 5 * (12 - n);
+         if (name_size == 13) {
+            // the 13th char only has the low 4 bits left, so it cannot be past 'j'
+            const uint64_t v = name_table[static_cast<uint8_t>(name_str[12])];
+            contract |= v & 0x0f;
+            bad |= static_cast<uint64_t>(v > 0x0f) << 5;
+         }
+         if (bad & invalid_name_char)
+            return xsym_error::invalid_contract;
+
+         code_raw = code;
+         contract_raw = contract;
+         return xsym_error::none;
+      }
+
+      /// writes as much of symbol code `raw` as fits in [begin, end) and returns the end of it
+      inline char* write_code(uint64_t raw, char* begin, char* end) {
+         for (; raw & 0xff && begin != end; raw >>= 8)
+            *begin++ = static_cast<char>(raw & 0xff);
+         return begin;
+      }
+
+      /// writes as much of name `value` as fits in [begin, end), without trailing dots, and returns the end of it
+      inline char* write_name(uint64_t value, char* begin, char* end) {
+         constexpr char charmap[] = ".12345abcdefghijklmnopqrstuvwxyz";
+         // the first 12 chars are 5 bits each from the top, the 13th is the low 4 bits
+         size_t len = 13;
+         if (!(value & 0x0f))
+            for (len = 12; len && !((value >> (64 - 5 * len)) & 0x1f); --len);
+         for (size_t i = 0; i < len && begin != end; ++i)
+            *begin++ = charmap[i < 12 ? (value >> (59 - 5 * i)) & 0x1f : value & 0x0f];
+         return begin;
+      }
+
+      // deliberately not constexpr: reaching it during constant evaluation is a compile error
+      inline void invalid_extended_symbol_code(xsym_error err) {
+         switch (err) {
+            case xsym_error::missing_separator: eosio::check(false, "extended symbol should contain '@'"); break;
+            case xsym_error::invalid_code:      eosio::check(false, "invalid symbol code in extended symbol"); break;
+            default:                            eosio::check(false, "invalid contract in extended symbol"); break;
+         }
+      }
+
+   }
+
    struct extended_symbol_code {
 
       constexpr extended_symbol_code() = default;
@@ -20,29 +147,66 @@ namespace eostd {
       : code(s), contract(c)
       {}
 
+      /// parses "CODE@contract", aborting if it is not a valid pair
       constexpr explicit extended_symbol_code( std::string_view str )
       : code(0), contract(0)
       {
-         auto at_pos = str.find('@');
-         if (at_pos == std::string_view::npos) {
-            eosio::check(false, "extended symbol should contain '@'");
+         if (auto err = try_parse(str, *this); err != xsym_error::none)
+            symbol_detail::invalid_extended_symbol_code(err);
+      }
+
+      /**
+       * Parses "CODE@contract" without aborting
+       * @brief Parses "CODE@contract" without aborting
+       *
+       * Usable in constant expressions. Both halves are validated as symbol_code and
+       * name validate them, and neither may be empty.
+       *
+       * @param str - String to parse, e.g. "EOS@eosio.token"
+       * @param out - Receives the pair; left untouched on error
+       * @return xsym_error - xsym_error::none, or why `str` is not a valid pair
+       */
+      static constexpr xsym_error try_parse( std::string_view str, extended_symbol_code& out ) {
+         uint64_t code_raw = 0, contract_raw = 0;
+         const auto err = symbol_detail::parse(str, code_raw, contract_raw);
+         if (err == xsym_error::none) {
+            out.code = symbol_code(code_raw);
+            out.contract = name(contract_raw);
          }
-         code = symbol_code(str.substr(0, at_pos));
-         contract = name(str.substr(at_pos+1));
+         return err;
       }
 
       constexpr uint128_t raw()const { return (uint128_t)contract.value << 64 | code.raw(); }
 
-      constexpr explicit operator bool()const { return !code.raw() && !contract.value; }
+      /// true unless both fields are zero
+      constexpr explicit operator bool()const { return code.raw() || contract.value; }
+
+      /// longest "CODE@contract" text
+      static constexpr size_t max_string_size = 7 + 1 + 13;
+
+      /**
+       * Writes "CODE@contract" to [begin, end), as much of it as fits
+       * @brief Writes "CODE@contract" to [begin, end), as much of it as fits
+       *
+       * @param begin - Start of the buffer
+       * @param end - End of the buffer; `max_string_size` chars always fit
+       * @return char* - Past the last char written
+       */
+      char* write_as_string(char* begin, char* end)const {
+         begin = symbol_detail::write_code(code.raw(), begin, end);
+         if (begin != end)
+            *begin++ = '@';
+         return symbol_detail::write_name(contract.value, begin, end);
+      }
 
       std::string to_string()const {
-         return code.to_string() + "@" + contract.to_string();
+         char str[max_string_size];
+         return std::string(str, write_as_string(str, str + sizeof(str)));
       }
 
       inline void print()const {
-         auto str = to_string();
-         if (str.size())
-            eosio::printl(str.data(), str.size());
+         char str[max_string_size];
+         eosio::printl(str, write_as_string(str, str + sizeof(str)) - str);
       }
 
       friend constexpr bool operator == ( const extended_symbol_code& a, const extended_symbol_code& b ) {
@@ -63,4 +227,56 @@ namespace eostd {
       EOSLIB_SERIALIZE(extended_symbol_code, (code)(contract))
    };
 
+   namespace literals {
+
+#if defined(__clang__) || defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wgnu-string-literal-operator-template"
+#endif
+      /**
+       * `"EOS@eosio.token"_xsym` is parsed at compile time; an invalid pair fails to compile
+       */
+      template<typename CharT, CharT... Cs>
+      constexpr extended_symbol_code operator""_xsym() {
+         constexpr char s[] = { static_cast<char>(Cs)..., '\0' };
+         constexpr auto x = extended_symbol_code(std::string_view(s, sizeof...(Cs)));
+         return x;
+      }
+#pragma GCC diagnostic pop
+#endif
+
+   } /// namespace literals
+
+   /**
+    * Secondary key extractor that indexes an extended_symbol_code member as idx128
+    *
+    * `indexed_by<"byxsym"_n, extended_symbol_code_key<row, &row::xsym>>` orders rows by
+    * raw(), i.e. by contract first and symbol code second.
+    */
+   template<typename T, extended_symbol_code T::*Member>
+   struct extended_symbol_code_key {
+      uint128_t operator()(const T& row)const { return (row.*Member).raw(); }
+
+      template<typename Ptr>
+      auto operator()(const Ptr& row)const -> std::enable_if_t<!std::is_convertible<const Ptr&, const T&>::value, uint128_t> {
+         return (*this)(*row);
+      }
+   };
+
+}
+
+namespace std {
+
+   template<>
+   struct hash<eostd::extended_symbol_code> {
+      size_t operator()(const eostd::extended_symbol_code& s)const {
+         // multiply-xorshift mixing, so the low bits open addressing masks out depend on both fields
+         uint64_t h = s.code.raw() * 0x9E3779B97F4A7C15ULL ^ s.contract.value;
+         h = (h ^ (h >> 32)) * 0xD6E8FEB86659FD93ULL;
+         return static_cast<size_t>(h ^ (h >> 32));
+      }
+   };
+
 }
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <eosio/name.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace eostd {
+
+   /// how table_cache lookups were served since the last clear
+   struct table_cache_stats {
+      uint32_t hits   = 0;   ///< lookups that found an open table
+      uint32_t misses = 0;   ///< lookups that had to open one
+   };
+
+   namespace table_cache_detail {
+
+      inline table_cache_stats& stats() {
+         static table_cache_stats _stats;
+         return _stats;
+      }
+
+      inline std::vector<void (*)()>& clear_functions() {
+         static std::vector<void (*)()> _functions;
+         return _functions;
+      }
+
+   }
+
+   /// an open table, and what the wrappers on it need to know of each other
+   template <typename T>
+   struct cached_table {
+      T        table;
+      uint64_t erasures = 0;   ///< bumped by every wrapper erase, so peers know to recheck their rows
+
+      cached_table(eosio::name code, uint64_t scope) : table(code, scope) {}
+   };
+
+   /**
+    * One open multi_index per (code, scope), shared by everything that asks for it
+    *
+    * multi_index keeps the rows it has loaded in its own instance, so two instances on
+    * the same table each read a row from the db, and the one that did not write it keeps
+    * a stale copy. Getting tables from here shares both the instance and its rows;
+    * wrappers do so when made with `shared_table`.
+    *
+    * The instance keeps every row it loads until the action ends, and multi_index looks
+    * rows up in them linearly, so a find costs more the more rows of the scope any part
+    * of the action has read. Actions that walk many rows of a scope and then seek in it
+    * pay for the walk on every seek, which is why sharing is opt-in.
+    *
+    * Contract memory does not outlive the action, so neither does the cache. Native code
+    * that runs several actions in one process calls clear_table_caches() between them,
+    * when no wrapper that took its table from here is left.
+    *
+    * An action opens few scopes of a table, so they are looked up linearly.
+    */
+   template <typename T>
+   class table_cache {
+   public:
+      static cached_table<T>& open(eosio::name code, uint64_t scope) {
+         auto& _tables = tables();
+         for (auto& _cached : _tables) {
+            if (_cached->table.get_scope() == scope && _cached->table.get_code() == code) {
+               ++table_cache_detail::stats().hits;
+               return *_cached;
+            }
+         }
+         ++table_cache_detail::stats().misses;
+         _tables.emplace_back(std::make_unique<cached_table<T>>(code, scope));
+         return *_tables.back();
+      }
+
+      static T& get(eosio::name code, uint64_t scope) { return open(code, scope).table; }
+
+      static void clear() { tables().clear(); }
+
+   private:
+      struct instances {
+         std::vector<std::unique_ptr<cached_table<T>>> tables;
+
+         instances() { table_cache_detail::clear_functions().push_back(&table_cache::clear); }
+      };
+
+      static std::vector<std::unique_ptr<cached_table<T>>>& tables() {
+         static instances _instances;
+         return _instances.tables;
+      }
+   };
+
+   /// a write a wrapper holds back from (code, scope), until another wrapper needs the table
+   struct held_write {
+      eosio::name code;
+      uint64_t    scope;
+      void*       owner;
+      void        (*write)(void* owner);   ///< makes the write and stops holding it
+      held_write* next;
+   };
+
+   /**
+    * Writes held back from tables of type `T`
+    *
+    * Wrappers make the writes held back from a (code, scope) before they open or read it,
+    * so every wrapper sees the table as it will be stored, whether it shares the table or
+    * not. Few writes are held at a time, so they are kept in a list.
+    */
+   template <typename T>
+   class held_writes {
+   public:
+      static void hold(held_write& write) {
+         write.next = head();
+         head() = &write;
+      }
+
+      static void release(held_write& write) {
+         for (auto** _p = &head(); *_p; _p = &(*_p)->next) {
+            if (*_p == &write) {
+               *_p = write.next;
+               return;
+            }
+         }
+      }
+
+      /// makes every write held back from (code, scope)
+      static void write(eosio::name code, uint64_t scope) {
+         // a write may make others as it reads the table, so each one starts over
+         for (auto* _w = head(); _w; ) {
+            if (_w->scope == scope && _w->code == code) {
+               _w->write(_w->owner);
+               _w = head();
+            } else {
+               _w = _w->next;
+            }
+         }
+      }
+
+   private:
+      static held_write*& head() {
+         static held_write* _head = nullptr;
+         return _head;
+      }
+   };
+
+   inline const table_cache_stats& table_cache_counters() { return table_cache_detail::stats(); }
+
+   /**
+    * Closes every cached table and zeroes the counters
+    *
+    * Shared wrappers and digest wrappers hold references to the cached tables, so none
+    * of them may outlive the call.
+    */
+   inline void clear_table_caches() {
+      for (auto _clear : table_cache_detail::clear_functions())
+         _clear();
+      table_cache_detail::stats() = {};
+   }
+
+}
@@ -29,6 +29,32 @@
 #include <string.h>
 #include "zeroize.h"
 
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define SHA256_BSWAP32(x) __builtin_bswap32(x)
+#elif defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && \
+    __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define SHA256_BSWAP32(x) (x)
+#endif
+
+#ifdef SHA256_BSWAP32
+
+/* One word load/store plus a byte swap instead of four byte accesses */
+static uint32_t be32dec(const void* pp)
+{
+    uint32_t x;
+    memcpy(&x, pp, 4);
+    return SHA256_BSWAP32(x);
+}
+
+static void be32enc(void* pp, uint32_t x)
+{
+    x = SHA256_BSWAP32(x);
+    memcpy(pp, &x, 4);
+}
+
+#else
+
 static uint32_t be32dec(const void* pp)
 {
     const uint8_t* p = (uint8_t const*)pp;
@@ -47,6 +73,8 @@ static void be32enc(void* pp, uint32_t x)
     p[0] = (x >> 24) & 0xff;
 }
 
+#endif
+
 static void be32enc_vect(uint8_t* dst, const uint32_t* src, size_t len)
 {
     size_t i;
@@ -269,8 +297,16 @@ void SHA256Transform(uint32_t state[SHA256_STATE_LENGTH],
         state[i] += S[i];
     }
 
+    /*
+     * The message schedule and working variables left on the stack by each
+     * block are only wiped when SHA256_ZEROIZE_BLOCKS is defined. Hashing in
+     * contracts is over public data, so by default the context is zeroized
+     * once, in SHA256Final.
+     */
+#ifdef SHA256_ZEROIZE_BLOCKS
     zeroize((void*)W, sizeof W);
     zeroize((void*)S, sizeof S);
     zeroize((void*)&t0, sizeof t0);
     zeroize((void*)&t1, sizeof t1);
+#endif
 }
@@ -53,6 +53,10 @@ void SHA256Init(SHA256CTX* context);
 void SHA256Update(SHA256CTX* context, const uint8_t* input, size_t length);
 void SHA256Final(SHA256CTX* context, uint8_t digest[SHA256_DIGEST_LENGTH]);
 
+/* Hashes `count` independent messages, several at a time where SIMD is available */
+void SHA256Many(const uint8_t* const inputs[], const size_t lengths[],
+    uint8_t digests[][SHA256_DIGEST_LENGTH], size_t count);
+
 #ifdef __cplusplus
 }
 #endif
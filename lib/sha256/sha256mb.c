@@ -0,0 +1,227 @@
+/**
+ * Multi-buffer SHA-256: compresses the blocks of several independent
+ * messages side by side, one message per vector lane.
+ *
+ * The lanes are written with the GCC/Clang vector extension, so the same
+ * code is lowered to AVX2 (8 lanes), SSE2, NEON or WASM SIMD128 (4 lanes)
+ * depending on what the compiler targets. Without SIMD every message goes
+ * through the regular single-stream path.
+ */
+#include "sha256.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#define LANES 8
+#elif defined(__SSE2__) || defined(__ARM_NEON) || defined(__wasm_simd128__)
+#define LANES 4
+#else
+#define LANES 1
+#endif
+
+#if LANES > 1
+
+typedef uint32_t vec __attribute__((vector_size(LANES * 4)));
+
+#define Ch(x, y, z)  ((x & (y ^ z)) ^ z)
+#define Maj(x, y, z) ((x & (y | z)) | (y & z))
+#define SHR(x, n)    (x >> n)
+#define ROTR(x, n)   ((x >> n) | (x << (32 - n)))
+#define S0(x)        (ROTR(x, 2) ^ ROTR(x, 13) ^ ROTR(x, 22))
+#define S1(x)        (ROTR(x, 6) ^ ROTR(x, 11) ^ ROTR(x, 25))
+#define s0(x)        (ROTR(x, 7) ^ ROTR(x, 18) ^ SHR(x, 3))
+#define s1(x)        (ROTR(x, 17) ^ ROTR(x, 19) ^ SHR(x, 10))
+
+static const uint32_t K[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t IV[SHA256_STATE_LENGTH] =
+{
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+    0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+static const uint8_t ZERO_BLOCK[SHA256_BLOCK_LENGTH];
+
+typedef struct lane
+{
+    const uint8_t* input;
+    size_t full;      /* whole blocks read straight from input */
+    size_t blocks;    /* full plus the one or two padded tail blocks */
+    uint8_t tail[2 * SHA256_BLOCK_LENGTH];
+} lane;
+
+static uint32_t be32dec(const uint8_t* p)
+{
+    uint32_t x;
+    memcpy(&x, p, 4);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    x = __builtin_bswap32(x);
+#endif
+    return x;
+}
+
+static void be32enc(uint8_t* p, uint32_t x)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    x = __builtin_bswap32(x);
+#endif
+    memcpy(p, &x, 4);
+}
+
+static void lane_init(lane* l, const uint8_t* input, size_t length)
+{
+    uint64_t bits = (uint64_t)length << 3;
+    size_t r = length % SHA256_BLOCK_LENGTH;
+    size_t tail_length = (r < 56) ? SHA256_BLOCK_LENGTH : 2 * SHA256_BLOCK_LENGTH;
+    int i;
+
+    l->input = input;
+    l->full = length / SHA256_BLOCK_LENGTH;
+    l->blocks = l->full + tail_length / SHA256_BLOCK_LENGTH;
+
+    memset(l->tail, 0, tail_length);
+    if (r)
+    {
+        memcpy(l->tail, input + l->full * SHA256_BLOCK_LENGTH, r);
+    }
+    l->tail[r] = 0x80;
+    for (i = 0; i < 8; i++)
+    {
+        l->tail[tail_length - 1 - i] = (uint8_t)(bits >> (8 * i));
+    }
+}
+
+static const uint8_t* lane_block(const lane* l, size_t b)
+{
+    if (b >= l->blocks)
+        return ZERO_BLOCK;
+    if (b < l->full)
+        return l->input + b * SHA256_BLOCK_LENGTH;
+    return l->tail + (b - l->full) * SHA256_BLOCK_LENGTH;
+}
+
+/* Compresses one block per lane; lanes outside `active` keep their state */
+static void transform_lanes(vec state[SHA256_STATE_LENGTH],
+    const uint8_t* const block[LANES], vec active)
+{
+    vec W[64];
+    vec a, b, c, d, e, f, g, h, t0, t1;
+    int i, j;
+
+    for (i = 0; i < 16; i++)
+    {
+        for (j = 0; j < LANES; j++)
+        {
+            W[i][j] = be32dec(block[j] + i * 4);
+        }
+    }
+
+    for (i = 16; i < 64; i++)
+    {
+        W[i] = s1(W[i - 2]) + W[i - 7] + s0(W[i - 15]) + W[i - 16];
+    }
+
+    a = state[0]; b = state[1]; c = state[2]; d = state[3];
+    e = state[4]; f = state[5]; g = state[6]; h = state[7];
+
+    for (i = 0; i < 64; i++)
+    {
+        t0 = h + S1(e) + Ch(e, f, g) + K[i] + W[i];
+        t1 = S0(a) + Maj(a, b, c);
+        h = g; g = f; f = e;
+        e = d + t0;
+        d = c; c = b; b = a;
+        a = t0 + t1;
+    }
+
+    state[0] += a & active; state[1] += b & active;
+    state[2] += c & active; state[3] += d & active;
+    state[4] += e & active; state[5] += f & active;
+    state[6] += g & active; state[7] += h & active;
+}
+
+static void hash_lanes(const uint8_t* const inputs[], const size_t lengths[],
+    uint8_t digests[][SHA256_DIGEST_LENGTH], size_t count)
+{
+    lane lanes[LANES];
+    const uint8_t* block[LANES];
+    vec state[SHA256_STATE_LENGTH];
+    vec active = {0};
+    size_t blocks = 0, b;
+    size_t i, j;
+
+    for (j = 0; j < LANES; j++)
+    {
+        if (j < count)
+            lane_init(&lanes[j], inputs[j], lengths[j]);
+        else
+            lanes[j].blocks = 0;
+
+        if (lanes[j].blocks > blocks)
+            blocks = lanes[j].blocks;
+    }
+
+    for (i = 0; i < SHA256_STATE_LENGTH; i++)
+    {
+        for (j = 0; j < LANES; j++)
+        {
+            state[i][j] = IV[i];
+        }
+    }
+
+    for (b = 0; b < blocks; b++)
+    {
+        for (j = 0; j < LANES; j++)
+        {
+            block[j] = lane_block(&lanes[j], b);
+            active[j] = (b < lanes[j].blocks) ? 0xffffffff : 0;
+        }
+        transform_lanes(state, block, active);
+    }
+
+    for (j = 0; j < count; j++)
+    {
+        for (i = 0; i < SHA256_STATE_LENGTH; i++)
+        {
+            be32enc(digests[j] + i * 4, state[i][j]);
+        }
+    }
+}
+
+void SHA256Many(const uint8_t* const inputs[], const size_t lengths[],
+    uint8_t digests[][SHA256_DIGEST_LENGTH], size_t count)
+{
+    size_t i, n;
+
+    for (i = 0; i < count; i += n)
+    {
+        n = (count - i < LANES) ? count - i : LANES;
+        hash_lanes(inputs + i, lengths + i, digests + i, n);
+    }
+}
+
+#else
+
+void SHA256Many(const uint8_t* const inputs[], const size_t lengths[],
+    uint8_t digests[][SHA256_DIGEST_LENGTH], size_t count)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        SHA256_(inputs[i], lengths[i], digests[i]);
+    }
+}
+
+#endif
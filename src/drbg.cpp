@@ -2,11 +2,52 @@
 
 namespace eostd {
 
-hash_drbg::hash_drbg(const byte* entropy, size_t entropy_length, const byte* nonce, size_t nonce_length, const byte* personalization, size_t personalization_length)
-: m_c(seed_length), m_v(seed_length), m_reseed(0) {
-   std::memset(m_c.data(), 0x00, m_c.size());
-   std::memset(m_v.data(), 0x00, m_v.size());
+namespace {
+
+   inline uint32_t load_be32(const byte* p) {
+      return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+   }
+
+   inline void store_be32(byte* p, uint32_t x) {
+      p[0] = x >> 24;
+      p[1] = x >> 16;
+      p[2] = x >> 8;
+      p[3] = x;
+   }
+
+   // v += addend, both big-endian, with the addend aligned to the end of v
+   void add_be(byte* v, size_t vlen, const byte* addend, size_t alen) {
+      assert(alen <= vlen);
 
+      uint64_t carry = 0;
+      size_t i = vlen, j = alen;
+
+      while (j >= 4) {
+         i -= 4;
+         j -= 4;
+         carry += (uint64_t)load_be32(v + i) + load_be32(addend + j);
+         store_be32(v + i, static_cast<uint32_t>(carry));
+         carry >>= 32;
+      }
+      while (j > 0) {
+         i--;
+         j--;
+         carry += v[i] + addend[j];
+         v[i] = static_cast<byte>(carry);
+         carry >>= 8;
+      }
+      while (carry && i > 0) {
+         i--;
+         carry += v[i];
+         v[i] = static_cast<byte>(carry);
+         carry >>= 8;
+      }
+   }
+
+}
+
+hash_drbg::hash_drbg(const byte* entropy, size_t entropy_length, const byte* nonce, size_t nonce_length, const byte* personalization, size_t personalization_length)
+: m_c{}, m_v{}, m_reseed(0) {
    if (entropy != nullptr && entropy_length != 0) {
       drbg_instantiate(entropy, entropy_length, nonce, nonce_length, personalization, personalization_length);
    }
@@ -36,13 +77,9 @@ void hash_drbg::drbg_instantiate(const byte* entropy, size_t entropy_length, con
 
    const byte zero = 0;
 
-   bytes t1(seed_length), t2(seed_length);
-
-   hash_update(entropy, entropy_length, nonce, nonce_length, personalization, personalization_length, nullptr, 0, t1.data(), t1.size());
-   hash_update(&zero, 1, t1.data(), t1.size(), nullptr, 0, nullptr, 0, t2.data(), t2.size());
+   hash_update(entropy, entropy_length, nonce, nonce_length, personalization, personalization_length, nullptr, 0, m_v.data(), m_v.size());
+   hash_update(&zero, 1, m_v.data(), m_v.size(), nullptr, 0, nullptr, 0, m_c.data(), m_c.size());
 
-   m_v = t1;
-   m_c = t2;
    m_reseed = 1;
 }
 
@@ -54,13 +91,12 @@ void hash_drbg::drbg_reseed(const byte* entropy, size_t entropy_length, const by
    const byte zero = 0;
    const byte one = 1;
 
-   bytes t1(seed_length), t2(seed_length);
+   seed t;
 
-   hash_update(&one, 1, m_v.data(), m_v.size(), entropy, entropy_length, additional, additional_length, t1.data(), t1.size());
-   hash_update(&zero, 1, t1.data(), t1.size(), nullptr, 0, nullptr, 0, t2.data(), t2.size());
+   hash_update(&one, 1, m_v.data(), m_v.size(), entropy, entropy_length, additional, additional_length, t.data(), t.size());
+   hash_update(&zero, 1, t.data(), t.size(), nullptr, 0, nullptr, 0, m_c.data(), m_c.size());
 
-   m_v = t1;
-   m_c = t2;
+   m_v = t;
    m_reseed = 1;
 }
 
@@ -70,44 +106,29 @@ void hash_drbg::hash_generate(const byte* additional, size_t additional_length,
    check(size <= max_bytes_per_request, "Request size exceeds limit");
    assert(additional_length <= max_additional_length);
 
+   byte w[sha256::digest_size];
+
    // Step 2
    if (additional && additional_length) {
       const byte two = 2;
-      m_temp.assign(sha256::digest_size, 0);
 
       m_hash.update(&two, 1);
       m_hash.update(m_v.data(), m_v.size());
       m_hash.update(additional, additional_length);
-      m_hash.final(m_temp.data());
-
-      assert(seed_length >= sha256::digest_size);
-      int carry = 0;
-      int j = sha256::digest_size - 1;
-      int i = seed_length - 1;
+      m_hash.final(w);
 
-      while (j >= 0) {
-         carry = m_v[i] + m_temp[j] + carry;
-         m_v[i] = static_cast<byte>(carry);
-         i--;
-         j--;
-         carry >>= 8;
-      }
-      while (i >= 0) {
-         carry = m_v[i] + carry;
-         m_v[i] = static_cast<byte>(carry);
-         i--;
-         carry >>= 8;
-      }
+      static_assert(seed_length >= sha256::digest_size);
+      add_be(m_v.data(), m_v.size(), w, sizeof(w));
    }
 
    // Step 3
-   m_temp.assign(m_v.begin(), m_v.end());
+   seed data = m_v;
    while (size) {
-      m_hash.update(m_temp.data(), m_temp.size());
+      m_hash.update(data.data(), data.size());
       size_t count = std::min(size, (size_t)sha256::digest_size);
       m_hash.truncated_final(output, count);
 
-      incremental_counter_by_one(m_temp.data(), static_cast<unsigned int>(m_temp.size()));
+      incremental_counter_by_one(data.data(), static_cast<unsigned int>(data.size()));
       size -= count;
       output+= count;
    }
@@ -115,41 +136,22 @@ void hash_drbg::hash_generate(const byte* additional, size_t additional_length,
    // Steps 4-7
    {
       const byte three = 3;
-      m_temp.assign(sha256::digest_size, 0);
 
       m_hash.update(&three, 1);
       m_hash.update(m_v.data(), m_v.size());
-      m_hash.final(m_temp.data());
+      m_hash.final(w);
 
-      assert(seed_length >= sha256::digest_size);
-      assert(sha256::digest_size >= sizeof(m_reseed));
+      static_assert(sha256::digest_size >= sizeof(m_reseed));
 
-      int carry = 0;
-      int k = sizeof(m_reseed) - 1;
-      int j = sha256::digest_size - 1;
-      int i = seed_length - 1;
+      // byte k from the end carries (m_reseed >> k) & 0xFF, as it always has,
+      // so that generated streams stay the same across releases
+      byte reseed[sizeof(m_reseed)];
+      for (unsigned int k = 0; k < sizeof(m_reseed); k++)
+         reseed[sizeof(m_reseed)-k-1] = static_cast<byte>(m_reseed >> k);
 
-      while (k >= 0) {
-         carry = m_v[i] + m_c[i] + m_temp[j] + ((m_reseed >> (sizeof(uint64_t)-k-1)) & 0xFF) + carry;
-         m_v[i] = static_cast<byte>(carry);
-         i--;
-         j--;
-         k--;
-         carry >>= 8;
-      }
-      while (j >= 0) {
-         carry = m_v[i] + m_c[i] + m_temp[j] + carry;
-         m_v[i] = static_cast<byte>(carry);
-         i--;
-         j--;
-         carry >>= 8;
-      }
-      while (i >= 0) {
-         carry = m_v[i] + m_c[i] + carry;
-         m_v[i] = static_cast<byte>(carry);
-         i--;
-         carry >>= 8;
-      }
+      add_be(m_v.data(), m_v.size(), m_c.data(), m_c.size());
+      add_be(m_v.data(), m_v.size(), w, sizeof(w));
+      add_be(m_v.data(), m_v.size(), reseed, sizeof(reseed));
    }
 
    m_reseed++;
@@ -0,0 +1,2 @@
+#define EOSTD_HEX_IMPL
+#include <eostd/hex.hpp>
@@ -0,0 +1,15 @@
+/**
+ * @file
+ * Host implementation of the sha256 intrinsic, served by the software
+ * SHA-256 so results can be compared with the in-contract path.
+ */
+#include <cstdint>
+#include "sha256/sha256.h"
+
+extern "C" {
+
+void sha256(const char* data, uint32_t length, void* hash) {
+   SHA256_(reinterpret_cast<const uint8_t*>(data), length, static_cast<uint8_t*>(hash));
+}
+
+}
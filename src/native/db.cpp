@@ -0,0 +1,491 @@
+/**
+ * @file
+ * Host implementations of the database intrinsics behind `eosio::multi_index`,
+ * kept in memory. Linked into eostd only when it is built with `EOSTD_NATIVE`.
+ *
+ * Iterators behave as nodeos hands them out: a row gets one iterator per action,
+ * reused whenever the row is reached again, and each table has one end iterator,
+ * numbered -2, -3, ... -1 means the table does not exist.
+ */
+#include <eostd/native/db.hpp>
+#include <eostd/table_cache.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace eostd { namespace native {
+
+   namespace {
+
+      [[noreturn]] void fail(const char* msg) {
+         std::fprintf(stderr, "db intrinsic failure: %s\n", msg);
+         std::abort();
+      }
+
+      // state lives in function statics, so the intrinsics work during static initialization too
+      struct session_state {
+         uint64_t       receiver = 0;
+         uint64_t       actions = 0;
+         db_call_counts action_calls;
+         db_call_counts total_calls;
+      };
+
+      session_state& session() {
+         static session_state _session;
+         return _session;
+      }
+
+      inline void count(db_intrinsic intrinsic) {
+         auto& _session = session();
+         ++_session.action_calls.calls[static_cast<size_t>(intrinsic)];
+         ++_session.total_calls.calls[static_cast<size_t>(intrinsic)];
+      }
+
+      using table_id = std::tuple<uint64_t, uint64_t, uint64_t>;   // code, scope, table
+
+      /**
+       * Iterators of one kind of table, valid for the current action
+       *
+       * `Position` is the container iterator of a row; its address identifies the row,
+       * so reaching a row twice hands out the same iterator.
+       */
+      template<typename Table, typename Position>
+      struct iterator_cache {
+         struct entry {
+            Table*   table;     ///< null once the row is removed
+            Position position;
+         };
+
+         std::vector<Table*>                       end_tables;
+         std::unordered_map<const Table*, int32_t> table_ends;
+         std::vector<entry>                        entries;
+         std::unordered_map<const void*, int32_t>  row_iterators;
+
+         int32_t end_of(Table* t) {
+            auto it = table_ends.find(t);
+            if (it != table_ends.end())
+               return it->second;
+            const int32_t end = -static_cast<int32_t>(end_tables.size()) - 2;
+            end_tables.push_back(t);
+            table_ends.emplace(t, end);
+            return end;
+         }
+
+         Table* table_of_end(int32_t end) {
+            const size_t i = static_cast<size_t>(-(end + 2));
+            if (end >= -1 || i >= end_tables.size())
+               fail("not an end iterator");
+            return end_tables[i];
+         }
+
+         int32_t add(Table* t, Position p) {
+            end_of(t);
+            auto r = row_iterators.emplace(&*p, static_cast<int32_t>(entries.size()));
+            if (r.second)
+               entries.push_back({ t, p });
+            return r.first->second;
+         }
+
+         /// copied, since adding an iterator may move the entries
+         entry get(int32_t i)const {
+            if (i < 0 || static_cast<size_t>(i) >= entries.size() || !entries[i].table)
+               fail("dereference of invalid iterator");
+            return entries[i];
+         }
+
+         void move(int32_t i, Position p) {
+            row_iterators.erase(&*entries[i].position);
+            entries[i].position = p;
+            row_iterators.emplace(&*p, i);
+         }
+
+         void remove(int32_t i) {
+            row_iterators.erase(&*entries[i].position);
+            entries[i].table = nullptr;
+         }
+
+         /// swapped out rather than cleared, which would keep and walk every bucket of a large action
+         void clear() {
+            std::vector<Table*>().swap(end_tables);
+            std::unordered_map<const Table*, int32_t>().swap(table_ends);
+            std::vector<entry>().swap(entries);
+            std::unordered_map<const void*, int32_t>().swap(row_iterators);
+         }
+      };
+
+      struct row {
+         uint64_t          payer;
+         std::vector<char> data;
+      };
+
+      using primary_table = std::map<uint64_t, row>;
+
+      /**
+       * One kind of secondary index, e.g. idx64
+       *
+       * Entries are ordered by (key, primary key), as nodeos orders them.
+       */
+      template<typename K, db_intrinsic First>
+      struct secondary_index {
+         using entry = std::pair<K, uint64_t>;
+
+         struct table {
+            std::set<entry>                                        by_key;
+            std::map<uint64_t, typename std::set<entry>::iterator> by_primary;
+         };
+
+         using position = typename std::set<entry>::iterator;
+
+         std::map<table_id, table>        tables;
+         iterator_cache<table, position> iterators;
+
+         // the intrinsics of one index are listed in the order of EOSTD_NATIVE_DB_SECONDARY_INTRINSICS
+         enum op { store, update, remove, next, previous, find_primary, find_secondary, lowerbound, upperbound, end };
+
+         static void count(op o) { native::count(static_cast<db_intrinsic>(static_cast<size_t>(First) + o)); }
+
+         table* find_table(uint64_t code, uint64_t scope, uint64_t t) {
+            auto it = tables.find(table_id{ code, scope, t });
+            return it == tables.end() ? nullptr : &it->second;
+         }
+
+         int32_t db_store(uint64_t scope, uint64_t t, uint64_t id, const K& key) {
+            count(store);
+            auto& tab = tables[table_id{ session().receiver, scope, t }];
+            if (tab.by_primary.count(id))
+               fail("secondary key for this primary key already exists");
+            auto it = tab.by_key.emplace(key, id).first;
+            tab.by_primary.emplace(id, it);
+            return iterators.add(&tab, it);
+         }
+
+         void db_update(int32_t i, const K& key) {
+            count(update);
+            auto e = iterators.get(i);
+            if (e.position->first == key)
+               return;
+            const uint64_t id = e.position->second;
+            auto it = e.table->by_key.emplace(key, id).first;
+            e.table->by_primary[id] = it;
+            iterators.move(i, it);
+            e.table->by_key.erase(e.position);
+         }
+
+         void db_remove(int32_t i) {
+            count(remove);
+            auto e = iterators.get(i);
+            iterators.remove(i);
+            e.table->by_primary.erase(e.position->second);
+            e.table->by_key.erase(e.position);
+         }
+
+         int32_t db_next(int32_t i, uint64_t* primary) {
+            count(next);
+            if (i < -1)
+               return -1;
+            auto e = iterators.get(i);
+            auto it = std::next(e.position);
+            if (it == e.table->by_key.end())
+               return iterators.end_of(e.table);
+            *primary = it->second;
+            return iterators.add(e.table, it);
+         }
+
+         int32_t db_previous(int32_t i, uint64_t* primary) {
+            count(previous);
+            table* t;
+            position it;
+            if (i < -1) {
+               t = iterators.table_of_end(i);
+               if (t->by_key.empty())
+                  return -1;
+               it = std::prev(t->by_key.end());
+            } else {
+               auto e = iterators.get(i);
+               t = e.table;
+               if (e.position == t->by_key.begin())
+                  return -1;
+               it = std::prev(e.position);
+            }
+            *primary = it->second;
+            return iterators.add(t, it);
+         }
+
+         int32_t db_find_primary(uint64_t code, uint64_t scope, uint64_t tn, K* key, uint64_t primary) {
+            count(find_primary);
+            auto t = find_table(code, scope, tn);
+            if (!t)
+               return -1;
+            auto it = t->by_primary.find(primary);
+            if (it == t->by_primary.end())
+               return iterators.end_of(t);
+            *key = it->second->first;
+            return iterators.add(t, it->second);
+         }
+
+         int32_t db_find_secondary(uint64_t code, uint64_t scope, uint64_t tn, const K* key, uint64_t* primary) {
+            count(find_secondary);
+            auto t = find_table(code, scope, tn);
+            if (!t)
+               return -1;
+            auto it = t->by_key.lower_bound(entry(*key, 0));
+            if (it == t->by_key.end() || it->first != *key)
+               return iterators.end_of(t);
+            *primary = it->second;
+            return iterators.add(t, it);
+         }
+
+         int32_t db_lowerbound(uint64_t code, uint64_t scope, uint64_t tn, K* key, uint64_t* primary) {
+            count(lowerbound);
+            return bound(find_table(code, scope, tn), key, primary, [&](table* t) { return t->by_key.lower_bound(entry(*key, 0)); });
+         }
+
+         int32_t db_upperbound(uint64_t code, uint64_t scope, uint64_t tn, K* key, uint64_t* primary) {
+            count(upperbound);
+            return bound(find_table(code, scope, tn), key, primary, [&](table* t) { return t->by_key.upper_bound(entry(*key, UINT64_MAX)); });
+         }
+
+         int32_t db_end(uint64_t code, uint64_t scope, uint64_t tn) {
+            count(end);
+            auto t = find_table(code, scope, tn);
+            return t ? iterators.end_of(t) : -1;
+         }
+
+      private:
+         template<typename Seek>
+         int32_t bound(table* t, K* key, uint64_t* primary, Seek seek) {
+            if (!t)
+               return -1;
+            auto it = seek(t);
+            if (it == t->by_key.end())
+               return iterators.end_of(t);
+            *key = it->first;
+            *primary = it->second;
+            return iterators.add(t, it);
+         }
+      };
+
+      struct database {
+         std::map<table_id, primary_table>                                  primary_tables;
+         iterator_cache<primary_table, primary_table::iterator>             primary_iterators;
+         secondary_index<uint64_t, db_intrinsic::db_idx64_store>            idx64;
+         secondary_index<unsigned __int128, db_intrinsic::db_idx128_store>  idx128;
+         secondary_index<double, db_intrinsic::db_idx_double_store>         idx_double;
+
+         void clear_iterators() {
+            primary_iterators.clear();
+            idx64.iterators.clear();
+            idx128.iterators.clear();
+            idx_double.iterators.clear();
+         }
+
+         primary_table* find_primary_table(uint64_t code, uint64_t scope, uint64_t table) {
+            auto it = primary_tables.find(table_id{ code, scope, table });
+            return it == primary_tables.end() ? nullptr : &it->second;
+         }
+      };
+
+      database& db() {
+         static database _db;
+         return _db;
+      }
+
+   }
+
+   const char* to_string(db_intrinsic intrinsic) {
+      static const char* names[] = {
+#define EOSTD_NATIVE_DB_NAME(name) #name,
+         EOSTD_NATIVE_DB_INTRINSICS(EOSTD_NATIVE_DB_NAME)
+#undef EOSTD_NATIVE_DB_NAME
+      };
+      return intrinsic < db_intrinsic::count ? names[static_cast<size_t>(intrinsic)] : "unknown";
+   }
+
+   void db_begin_action(eosio::name receiver) {
+      auto& _session = session();
+      _session.receiver = receiver.value;
+      ++_session.actions;
+      _session.action_calls = {};
+      db().clear_iterators();
+      clear_table_caches();
+   }
+
+   void db_reset() {
+      auto& _db = db();
+      _db.primary_tables.clear();
+      _db.idx64.tables.clear();
+      _db.idx128.tables.clear();
+      _db.idx_double.tables.clear();
+      _db.clear_iterators();
+      clear_table_caches();
+      auto& _session = session();
+      _session.action_calls = {};
+      _session.total_calls = {};
+      _session.actions = 0;
+   }
+
+   const db_call_counts& db_action_calls() { return session().action_calls; }
+   const db_call_counts& db_total_calls() { return session().total_calls; }
+   uint64_t db_actions() { return session().actions; }
+
+   void db_print_calls(const db_call_counts& counts) {
+      for (size_t i = 0; i < static_cast<size_t>(db_intrinsic::count); ++i) {
+         if (counts.calls[i])
+            std::printf("%-28s %12llu\n", to_string(static_cast<db_intrinsic>(i)), static_cast<unsigned long long>(counts.calls[i]));
+      }
+   }
+
+} } /// namespace eostd::native
+
+using namespace eostd::native;
+
+extern "C" {
+
+uint64_t current_receiver() {
+   return session().receiver;
+}
+
+int32_t db_store_i64(uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, const void* data, uint32_t len) {
+   count(db_intrinsic::db_store_i64);
+   auto& t = db().primary_tables[table_id{ session().receiver, scope, table }];
+   auto bytes = static_cast<const char*>(data);
+   auto r = t.emplace(id, row{ payer, std::vector<char>(bytes, bytes + len) });
+   if (!r.second)
+      fail("db_store_i64: primary key already exists");
+   return db().primary_iterators.add(&t, r.first);
+}
+
+void db_update_i64(int32_t iterator, uint64_t payer, const void* data, uint32_t len) {
+   count(db_intrinsic::db_update_i64);
+   auto& r = db().primary_iterators.get(iterator).position->second;
+   auto bytes = static_cast<const char*>(data);
+   r.payer = payer;
+   r.data.assign(bytes, bytes + len);
+}
+
+void db_remove_i64(int32_t iterator) {
+   count(db_intrinsic::db_remove_i64);
+   auto e = db().primary_iterators.get(iterator);
+   db().primary_iterators.remove(iterator);
+   e.table->erase(e.position);
+}
+
+int32_t db_get_i64(int32_t iterator, void* data, uint32_t len) {
+   count(db_intrinsic::db_get_i64);
+   const auto& d = db().primary_iterators.get(iterator).position->second.data;
+   if (len == 0)
+      return static_cast<int32_t>(d.size());
+   const uint32_t n = std::min<uint32_t>(len, d.size());
+   std::memcpy(data, d.data(), n);
+   return static_cast<int32_t>(n);
+}
+
+int32_t db_next_i64(int32_t iterator, uint64_t* primary) {
+   count(db_intrinsic::db_next_i64);
+   if (iterator < -1)
+      return -1;
+   auto e = db().primary_iterators.get(iterator);
+   auto it = std::next(e.position);
+   if (it == e.table->end())
+      return db().primary_iterators.end_of(e.table);
+   *primary = it->first;
+   return db().primary_iterators.add(e.table, it);
+}
+
+int32_t db_previous_i64(int32_t iterator, uint64_t* primary) {
+   count(db_intrinsic::db_previous_i64);
+   primary_table* t;
+   primary_table::iterator it;
+   if (iterator < -1) {
+      t = db().primary_iterators.table_of_end(iterator);
+      if (t->empty())
+         return -1;
+      it = std::prev(t->end());
+   } else {
+      auto e = db().primary_iterators.get(iterator);
+      t = e.table;
+      if (e.position == t->begin())
+         return -1;
+      it = std::prev(e.position);
+   }
+   *primary = it->first;
+   return db().primary_iterators.add(t, it);
+}
+
+int32_t db_find_i64(uint64_t code, uint64_t scope, uint64_t table, uint64_t id) {
+   count(db_intrinsic::db_find_i64);
+   auto t = db().find_primary_table(code, scope, table);
+   if (!t)
+      return -1;
+   auto it = t->find(id);
+   return it == t->end() ? db().primary_iterators.end_of(t) : db().primary_iterators.add(t, it);
+}
+
+int32_t db_lowerbound_i64(uint64_t code, uint64_t scope, uint64_t table, uint64_t id) {
+   count(db_intrinsic::db_lowerbound_i64);
+   auto t = db().find_primary_table(code, scope, table);
+   if (!t)
+      return -1;
+   auto it = t->lower_bound(id);
+   return it == t->end() ? db().primary_iterators.end_of(t) : db().primary_iterators.add(t, it);
+}
+
+int32_t db_upperbound_i64(uint64_t code, uint64_t scope, uint64_t table, uint64_t id) {
+   count(db_intrinsic::db_upperbound_i64);
+   auto t = db().find_primary_table(code, scope, table);
+   if (!t)
+      return -1;
+   auto it = t->upper_bound(id);
+   return it == t->end() ? db().primary_iterators.end_of(t) : db().primary_iterators.add(t, it);
+}
+
+int32_t db_end_i64(uint64_t code, uint64_t scope, uint64_t table) {
+   count(db_intrinsic::db_end_i64);
+   auto t = db().find_primary_table(code, scope, table);
+   return t ? db().primary_iterators.end_of(t) : -1;
+}
+
+#define EOSTD_NATIVE_SECONDARY(IDX, K) \
+int32_t db_##IDX##_store(uint64_t scope, uint64_t table, uint64_t, uint64_t id, const K* key) { \
+   return db().IDX.db_store(scope, table, id, *key); \
+} \
+void db_##IDX##_update(int32_t iterator, uint64_t, const K* key) { \
+   db().IDX.db_update(iterator, *key); \
+} \
+void db_##IDX##_remove(int32_t iterator) { \
+   db().IDX.db_remove(iterator); \
+} \
+int32_t db_##IDX##_next(int32_t iterator, uint64_t* primary) { \
+   return db().IDX.db_next(iterator, primary); \
+} \
+int32_t db_##IDX##_previous(int32_t iterator, uint64_t* primary) { \
+   return db().IDX.db_previous(iterator, primary); \
+} \
+int32_t db_##IDX##_find_primary(uint64_t code, uint64_t scope, uint64_t table, K* key, uint64_t primary) { \
+   return db().IDX.db_find_primary(code, scope, table, key, primary); \
+} \
+int32_t db_##IDX##_find_secondary(uint64_t code, uint64_t scope, uint64_t table, const K* key, uint64_t* primary) { \
+   return db().IDX.db_find_secondary(code, scope, table, key, primary); \
+} \
+int32_t db_##IDX##_lowerbound(uint64_t code, uint64_t scope, uint64_t table, K* key, uint64_t* primary) { \
+   return db().IDX.db_lowerbound(code, scope, table, key, primary); \
+} \
+int32_t db_##IDX##_upperbound(uint64_t code, uint64_t scope, uint64_t table, K* key, uint64_t* primary) { \
+   return db().IDX.db_upperbound(code, scope, table, key, primary); \
+} \
+int32_t db_##IDX##_end(uint64_t code, uint64_t scope, uint64_t table) { \
+   return db().IDX.db_end(code, scope, table); \
+}
+
+EOSTD_NATIVE_SECONDARY(idx64, uint64_t)
+EOSTD_NATIVE_SECONDARY(idx128, unsigned __int128)
+EOSTD_NATIVE_SECONDARY(idx_double, double)
+
+}
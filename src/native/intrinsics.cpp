@@ -0,0 +1,153 @@
+/**
+ * @file
+ * Host implementations of the intrinsics behind `eosio::check` and `eosio::print`.
+ * Linked into eostd only when it is built with `EOSTD_NATIVE`.
+ */
+#include <eostd/native/print.hpp>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+   struct print_state {
+      uint64_t     calls   = 0;
+      std::string* capture = nullptr;
+   };
+
+   // a function static, so that printing works during static initialization too
+   print_state& printer() {
+      static print_state _state;
+      return _state;
+   }
+
+   /// writes printed text, counting the intrinsic call it came from
+   void emit(const char* str, size_t len) {
+      auto& _printer = printer();
+      ++_printer.calls;
+      if (_printer.capture)
+         _printer.capture->append(str, len);
+      else
+         std::fwrite(str, 1, len, stdout);
+   }
+
+   template<typename... Args>
+   void emitf(const char* format, Args... args) {
+      char buf[64];
+      int len = std::snprintf(buf, sizeof(buf), format, args...);
+      emit(buf, static_cast<size_t>(len) < sizeof(buf) ? len : sizeof(buf) - 1);
+   }
+
+   [[noreturn]] void abort_with(const char* msg, size_t len) {
+      std::fprintf(stderr, "assertion failure with message: %.*s\n", static_cast<int>(len), msg);
+      std::abort();
+   }
+
+   void print_u128(unsigned __int128 v, bool negative) {
+      char buf[41];
+      char* p = buf + sizeof(buf);
+      do {
+         *--p = '0' + static_cast<char>(v % 10);
+         v /= 10;
+      } while (v);
+      if (negative)
+         *--p = '-';
+      emit(p, buf + sizeof(buf) - p);
+   }
+
+}
+
+namespace eostd { namespace native {
+
+   uint64_t print_calls() { return printer().calls; }
+
+   void capture_prints(std::string* sink) { printer().capture = sink; }
+
+} } /// namespace eostd::native
+
+extern "C" {
+
+void eosio_assert(uint32_t test, const char* msg) {
+   if (!test)
+      abort_with(msg, std::strlen(msg));
+}
+
+void eosio_assert_message(uint32_t test, const char* msg, uint32_t msg_len) {
+   if (!test)
+      abort_with(msg, msg_len);
+}
+
+void eosio_assert_code(uint32_t test, uint64_t code) {
+   if (!test) {
+      std::fprintf(stderr, "assertion failure with error code: %" PRIu64 "\n", code);
+      std::abort();
+   }
+}
+
+void prints(const char* cstr) {
+   emit(cstr, std::strlen(cstr));
+}
+
+void prints_l(const char* cstr, uint32_t len) {
+   emit(cstr, len);
+}
+
+void printi(int64_t value) {
+   emitf("%" PRId64, value);
+}
+
+void printui(uint64_t value) {
+   emitf("%" PRIu64, value);
+}
+
+void printi128(const __int128* value) {
+   unsigned __int128 v = *value;
+   print_u128(*value < 0 ? -v : v, *value < 0);
+}
+
+void printui128(const unsigned __int128* value) {
+   print_u128(*value, false);
+}
+
+void printsf(float value) {
+   emitf("%.*e", 8, static_cast<double>(value));
+}
+
+void printdf(double value) {
+   emitf("%.*e", 16, value);
+}
+
+void printqf(const long double* value) {
+   emitf("%.*Le", 33, *value);
+}
+
+void printn(uint64_t name) {
+   static const char* charmap = ".12345abcdefghijklmnopqrstuvwxyz";
+   char str[13];
+   uint64_t tmp = name;
+   for (int i = 0; i <= 12; ++i) {
+      char c = charmap[tmp & (i == 0 ? 0x0f : 0x1f)];
+      str[12-i] = c;
+      tmp >>= (i == 0 ? 4 : 5);
+   }
+   int len = 13;
+   while (len > 0 && str[len-1] == '.')
+      --len;
+   emit(str, len);
+}
+
+void printhex(const void* data, uint32_t datalen) {
+   static const char* digits = "0123456789abcdef";
+   auto p = static_cast<const uint8_t*>(data);
+   std::string hex(datalen * 2, '0');
+   for (uint32_t i = 0; i < datalen; ++i) {
+      hex[2*i]   = digits[p[i] >> 4];
+      hex[2*i+1] = digits[p[i] & 0x0f];
+   }
+   emit(hex.data(), hex.size());
+}
+
+}
@@ -1,46 +1,45 @@
 #include <eostd/crypto/sha256.hpp>
 #include <eosio/check.hpp>
-#include "sha256/sha256.h"
+#include <cstring>
 
-namespace eostd {
-
-class sha256_impl {
-public:
-   sha256_impl() {
-      init();
-   }
-
-   void init() {
-      SHA256Init(&context);
-   }
-
-   void update(const uint8_t* input, size_t length) {
-      SHA256Update(&context, input, length);
+#if EOSTD_SHA256_INTRINSIC
+namespace eostd { namespace internal_use_do_not_use {
+   extern "C" {
+      __attribute__((eosio_wasm_import))
+      void sha256(const char* data, uint32_t length, void* hash);
    }
+} }
+#endif
 
-   void final(uint8_t digest[SHA256_DIGEST_LENGTH]) {
-      SHA256Final(&context, digest);
-   }
-
-private:
-   SHA256CTX context;
-};
-
+namespace eostd {
 
-sha256::sha256(): my(std::make_shared<sha256_impl>()) {
+void sha256_digest(const byte* data, size_t length, byte* digest) {
+#if EOSTD_SHA256_INTRINSIC
+   alignas(16) byte output[SHA256_DIGEST_LENGTH];
+   internal_use_do_not_use::sha256(reinterpret_cast<const char*>(data), static_cast<uint32_t>(length), output);
+   std::memcpy(digest, output, sizeof(output));
+#else
+   SHA256_(data, length, digest);
+#endif
 }
 
-void sha256::init() {
-   my->init();
-}
+void sha256::init(const sha256_midstate& m) {
+   eosio::check(m.length % block_size == 0, "Midstate must end on a block boundary");
 
-void sha256::update(const byte* input, size_t length) {
-   my->update(input, length);
+   const uint64_t bits = m.length << 3;
+   std::memcpy(context.state, m.state, sizeof(context.state));
+   context.count[0] = static_cast<uint32_t>(bits >> 32);
+   context.count[1] = static_cast<uint32_t>(bits);
 }
 
-void sha256::final(byte* digest) {
-   my->final(digest);
-   my->init();
+sha256_midstate sha256::midstate()const {
+   const uint64_t bits = static_cast<uint64_t>(context.count[0]) << 32 | context.count[1];
+   eosio::check((bits >> 3) % block_size == 0, "Midstate is only available on a block boundary");
+
+   sha256_midstate m;
+   std::memcpy(m.state, context.state, sizeof(m.state));
+   m.length = bits >> 3;
+   return m;
 }
 
 void sha256::truncated_final(byte* digest, size_t size) {
@@ -1,7 +1,27 @@
 #include <eostd/crypto/xxhash.hpp>
 
+#define XXH_STATIC_LINKING_ONLY
 #include "xxHash/xxhash.h"
 
+namespace {
+   /// the xxHash state kept in `opaque`, which has to be large and aligned enough for it
+   template<typename State, size_t Size, size_t Align>
+   State* as(eostd::xxhash_detail::opaque_state<Size, Align>& opaque) {
+      static_assert(sizeof(State) <= Size && alignof(State) <= Align, "opaque_state too small for xxHash's state");
+      return reinterpret_cast<State*>(opaque.bytes);
+   }
+
+   template<typename State, size_t Size, size_t Align>
+   const State* as(const eostd::xxhash_detail::opaque_state<Size, Align>& opaque) {
+      static_assert(sizeof(State) <= Size && alignof(State) <= Align, "opaque_state too small for xxHash's state");
+      return reinterpret_cast<const State*>(opaque.bytes);
+   }
+
+   inline __uint128_t to_uint128(XXH128_hash_t h) {
+      return (__uint128_t)h.high64 << 64 | h.low64;
+   }
+}
+
 uint32_t eostd::xxh32(const char* data, uint32_t length, uint32_t seed) {
    return ::XXH32(data, length, seed);
 }
@@ -9,3 +29,69 @@ uint32_t eostd::xxh32(const char* data, uint32_t length, uint32_t seed) {
 uint64_t eostd::xxh64(const char* data, uint32_t length, uint64_t seed) {
    return ::XXH64(data, length, seed);
 }
+
+uint64_t eostd::xxh3_64(const char* data, uint32_t length, uint64_t seed) {
+   return ::XXH3_64bits_withSeed(data, length, seed);
+}
+
+__uint128_t eostd::xxh3_128(const char* data, uint32_t length, uint64_t seed) {
+   return to_uint128(::XXH3_128bits_withSeed(data, length, seed));
+}
+
+void eostd::xxh32_state::reset(uint32_t seed) {
+   ::XXH32_reset(as<XXH32_state_t>(state), seed);
+}
+
+void eostd::xxh32_state::update(const char* data, uint32_t length) {
+   ::XXH32_update(as<XXH32_state_t>(state), data, length);
+}
+
+uint32_t eostd::xxh32_state::digest()const {
+   return ::XXH32_digest(as<XXH32_state_t>(state));
+}
+
+void eostd::xxh64_state::reset(uint64_t seed) {
+   ::XXH64_reset(as<XXH64_state_t>(state), seed);
+}
+
+void eostd::xxh64_state::update(const char* data, uint32_t length) {
+   ::XXH64_update(as<XXH64_state_t>(state), data, length);
+}
+
+uint64_t eostd::xxh64_state::digest()const {
+   return ::XXH64_digest(as<XXH64_state_t>(state));
+}
+
+eostd::xxh3_64_state::xxh3_64_state(uint64_t seed) {
+   XXH3_INITSTATE(as<XXH3_state_t>(state));
+   reset(seed);
+}
+
+void eostd::xxh3_64_state::reset(uint64_t seed) {
+   ::XXH3_64bits_reset_withSeed(as<XXH3_state_t>(state), seed);
+}
+
+void eostd::xxh3_64_state::update(const char* data, uint32_t length) {
+   ::XXH3_64bits_update(as<XXH3_state_t>(state), data, length);
+}
+
+uint64_t eostd::xxh3_64_state::digest()const {
+   return ::XXH3_64bits_digest(as<XXH3_state_t>(state));
+}
+
+eostd::xxh3_128_state::xxh3_128_state(uint64_t seed) {
+   XXH3_INITSTATE(as<XXH3_state_t>(state));
+   reset(seed);
+}
+
+void eostd::xxh3_128_state::reset(uint64_t seed) {
+   ::XXH3_128bits_reset_withSeed(as<XXH3_state_t>(state), seed);
+}
+
+void eostd::xxh3_128_state::update(const char* data, uint32_t length) {
+   ::XXH3_128bits_update(as<XXH3_state_t>(state), data, length);
+}
+
+__uint128_t eostd::xxh3_128_state::digest()const {
+   return to_uint128(::XXH3_128bits_digest(as<XXH3_state_t>(state)));
+}